@@ -23,6 +23,7 @@
 #include <cstdint>
 #include <iosfwd>
 #include <string>
+#include <vector>
 #include <memory> 
 
 // forward
@@ -58,6 +59,12 @@ namespace vp
     bool Import( const std::string& FileName );
     bool Export( const std::string& FileName, const bool OverWrite = false ) const;
 
+    // in-memory IO, throw if data is not valid
+    void Import( const uint8_t* Data, const size_t Size );
+    void ImportFrom( std::istream& is );
+    void ExportTo( std::vector<uint8_t>& Data ) const;
+    void ExportTo( std::ostream& os ) const;
+
     // bpp
     uint8_t BitsPerPixel() const;
 
@@ -51,6 +51,13 @@ namespace vp
     bool operator==( const GifImage& ) const;
     bool operator!=( const GifImage& ) const;
 
+    // hash of the colors of pixels, and of origin and dimension,
+    // equal for images that compare equal. Kept until pixels or
+    // the color table change. It reads all pixels, so it pays off
+    // when an image is compared with many others, e.g. to bucket
+    // frames; to compare two images once, operator== is cheaper.
+    uint64_t Hash() const;
+
     // bpp
     uint8_t  BitsPerPixel() const;
     void     BitsPerPixel( const uint8_t Bpp );
@@ -65,6 +72,7 @@ namespace vp
 
     // pixels
     bool    Interlaced() const;
+    void    Interlaced( const bool Interlace );  // written interlaced on export
     void    SetAllPixels( const uint8_t Index );
     void    SetPixel( const uint16_t X, const uint16_t Y, const uint8_t Index );
     uint8_t GetPixel( const uint16_t X, const uint16_t Y ) const;
@@ -72,6 +80,29 @@ namespace vp
                       uint8_t& Red, uint8_t& Green, uint8_t& Blue ) const;
     bool    Transparent( const uint16_t X, const uint16_t Y ) const;
 
+    // pixels in bulk, Indices holds Width() indices for a row, or
+    // Width x Height indices for a rectangle, row by row
+    void    SetRow( const uint16_t Y, const uint8_t* Indices );
+    void    GetRow( const uint16_t Y, uint8_t* Indices ) const;
+    void    SetRect( const uint16_t X, const uint16_t Y,
+                     const uint16_t Width, const uint16_t Height, const uint8_t* Indices );
+    void    GetRect( const uint16_t X, const uint16_t Y,
+                     const uint16_t Width, const uint16_t Height, uint8_t* Indices ) const;
+
+    // Width() x Height() indices, row by row, valid until
+    // pixels, bpp or dimension change
+    const uint8_t* Data() const;
+
+    // colors of pixels, 3 bytes (RGB) or 4 bytes (RGBA) per pixel,
+    // row by row, of the whole image or a rectangle. Alpha is 0 for
+    // transparent pixels, 255 otherwise.
+    void    GetRGB( uint8_t* RGB ) const;
+    void    GetRGBA( uint8_t* RGBA ) const;
+    void    GetRGB( const uint16_t X, const uint16_t Y,
+                    const uint16_t Width, const uint16_t Height, uint8_t* RGB ) const;
+    void    GetRGBA( const uint16_t X, const uint16_t Y,
+                     const uint16_t Width, const uint16_t Height, uint8_t* RGBA ) const;
+
     // delay
     uint16_t Delay() const;
     void     Delay( const uint16_t Centisecond );
@@ -0,0 +1,105 @@
+////////////////////////////////////////////////////////////////////////
+// Copyright (C) 2019 Xueyi Yao
+//
+// This file is part of VPixels.
+//
+// VPixels is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+// 
+// VPixels is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+// 
+// You should have received a copy of the GNU General Public License
+// along with VPixels.  If not, see <https://www.gnu.org/licenses/>.
+////////////////////////////////////////////////////////////////////////
+
+#ifndef VP_GIFPASSMANAGER_H
+#define VP_GIFPASSMANAGER_H
+
+#include <cstddef>
+#include <functional>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace vp
+{
+  class Gif;
+
+  ////////////////////////////////////////////////////////////////
+  // Runs passes over a Gif, in the order they are added, each a change
+  // that makes it smaller to export, and tells what each saves.
+  // Built-in passes render the same frames, or the same frames for
+  // longer, as their merged delays add up:
+  //   Remove1PixelImages: remove transparent 1 x 1 images, and add their
+  //                       delays to those of the images before
+  //   RemoveDuplicates:   remove images equal to the images before, and
+  //                       add their delays to those of the images before
+  //   OptimizeFrames:     see Gif::OptimizeFrames()
+  //   SingleColorTable:   put the colors in use, if no more than 256,
+  //                       in the global color table, none local
+  //   CommonColorTable:   make the colors of a local color table, that
+  //                       most images can use, the global color table
+  //   LocalColorTables:   reduce local color tables to the colors in
+  //                       use, and remove the global one if not in use
+  //   ReduceBpp:          code each image with as few bits per pixel as
+  //                       its largest color index needs
+  // A pass is a function that changes a Gif, and returns true if it
+  // changes. A Gif is not to be shared by threads, but Run() is const,
+  // so a manager can run passes over different Gifs at the same time.
+  /////////////////////////////////////////////////////////////////
+  class GifPassManager
+  {
+  public:
+    enum class Pass
+    {
+      Remove1PixelImages,
+      RemoveDuplicates,
+      OptimizeFrames,
+      SingleColorTable,
+      CommonColorTable,
+      LocalColorTables,
+      ReduceBpp
+    };
+
+    using Function = std::function<bool( Gif& )>;
+
+    // what a pass did to a Gif
+    struct Result
+    {
+      std::string Name;
+      bool        Changed;
+      size_t      SizeBefore;  // bytes to export, 0 if not measured
+      size_t      SizeAfter;
+    };
+
+    // no passes
+    GifPassManager() = default;
+
+    // the passes of GifDownsize, in this order: RemoveDuplicates,
+    // OptimizeFrames, Remove1PixelImages, SingleColorTable,
+    // CommonColorTable, LocalColorTables, ReduceBpp
+    static GifPassManager Downsize();
+
+    static std::string Name( const Pass );
+
+    // passes
+    void   Add( const Pass );
+    void   Add( const std::string& Name, Function Func );
+    size_t Passes() const;
+    const std::string& Name( const size_t Index ) const;
+
+    // Run all passes on a Gif. If Measure, the size to export is taken
+    // before and after each pass, which encodes the images changed.
+    std::vector<Result> Run( Gif& Animation, const bool Measure = false ) const;
+
+  private:
+    std::vector<std::pair<std::string, Function>> m_Passes;
+  };
+
+} //namespace vp
+#endif //VP_GIFPASSMANAGER_H
@@ -0,0 +1,79 @@
+////////////////////////////////////////////////////////////////////////
+// Copyright (C) 2019 Xueyi Yao
+//
+// This file is part of VPixels.
+//
+// VPixels is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+// 
+// VPixels is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+// 
+// You should have received a copy of the GNU General Public License
+// along with VPixels.  If not, see <https://www.gnu.org/licenses/>.
+////////////////////////////////////////////////////////////////////////
+
+#ifndef VP_GIFRENDERER_H
+#define VP_GIFRENDERER_H
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+
+// forward
+struct GifRendererImpl;
+
+namespace vp
+{
+  class Gif;
+
+  ////////////////////////////////////////////////////////////////
+  // Renders frames of an animation as a viewer shows them, onto an
+  // RGBA canvas of the logical screen size, 4 bytes per pixel, row by
+  // row. Each image is drawn at its offset with transparent pixels left
+  // out, and is disposed of before the next one by its disposal method:
+  //   0, 1: left in place
+  //   2:    its area restored to the background
+  //   3:    its area restored to what it was before it was drawn
+  // The background is transparent, or the background color of the
+  // global color table if Background is true.
+  //
+  // Rendering the next frame only touches the areas of two images. The
+  // canvas is kept every KeyframeInterval frames, so rendering an
+  // earlier frame starts from the nearest one kept.
+  //
+  // The Gif must outlive the renderer. If it changes, call Reset().
+  /////////////////////////////////////////////////////////////////
+  class GifRenderer
+  {
+  public:
+    explicit GifRenderer( const Gif& Animation, const bool Background = false,
+                          const size_t KeyframeInterval = 16 );
+    ~GifRenderer();
+
+    // not implemented
+    GifRenderer( const GifRenderer& ) = delete;
+    GifRenderer( GifRenderer&& ) = delete;
+    GifRenderer& operator=( const GifRenderer& ) = delete;
+    GifRenderer& operator=( GifRenderer&& ) = delete;
+
+    // canvas dimension
+    uint16_t Width() const;
+    uint16_t Height() const;
+
+    // Render frame Index, return the canvas, valid until next call
+    const uint8_t* Render( const size_t Index );
+
+    // start over, after the Gif has changed
+    void Reset();
+
+  private:
+    std::unique_ptr<GifRendererImpl> m_pImpl;
+  };
+
+} //namespace vp
+#endif //VP_GIFRENDERER_H
@@ -74,6 +74,30 @@ bool Bmp::Export( const std::string& FileName, const bool OverWrite ) const
   return GetImpl()->Export( FileName, OverWrite );
 }
 
+//////////////////////////////////////////////
+void Bmp::Import( const uint8_t* Data, const size_t Size )
+{
+  GetImpl()->Import( Data, Size );
+}
+
+//////////////////////////////////////////////
+void Bmp::ImportFrom( std::istream& is )
+{
+  GetImpl()->ImportFrom( is );
+}
+
+//////////////////////////////////////////////
+void Bmp::ExportTo( std::vector<uint8_t>& Data ) const
+{
+  GetImpl()->ExportTo( Data );
+}
+
+//////////////////////////////////////////////
+void Bmp::ExportTo( std::ostream& os ) const
+{
+  GetImpl()->ExportTo( os );
+}
+
 ///////////////////////////////
 uint8_t Bmp::BitsPerPixel() const
 {
@@ -19,6 +19,8 @@
 
 #include "BmpImpl.h"
 #include "Exception.h"
+#include "MappedFile.h"
+#include "MemoryBuf.h"
 #include <fstream>
 
 /////////////////////////////////////////
@@ -44,32 +46,36 @@ BmpImpl::BmpImpl( const BmpImpl& other )
 //////////////////////////////////////////////
 bool BmpImpl::Import( const std::string& FileName )
 {
-  std::ifstream File;
-
-  // check existence
-  File.open( FileName, std::ios::binary );
-  if( !File.is_open() )
+  // map the file into memory, and parse it in place
+  MappedFile File( FileName );
+  if( !File )
     return false;
 
-  try
-  {
-    // read from file
-    Read( File );
+  Import( File.Data(), File.Size() );
 
-    if( File.fail() )
-    {
-      File.close();
-      throw vp::Exception( "not a valid BMP file" );
-    }
+  return true;
+}
 
-    File.close();
-    return true;
-  }
-  catch( const vp::Exception& )
-  {
-    File.close();
-    throw;
-  }
+//////////////////////////////////////////////
+// import BMP data in memory, throw if it is not valid
+/////////////////////////////////////////////////////////
+void BmpImpl::Import( const uint8_t* pData, const size_t Size )
+{
+  MemoryBuf Buffer( pData, Size );
+  std::istream is( &Buffer );
+
+  ImportFrom( is );
+}
+
+//////////////////////////////////////////////
+// import BMP data from stream, throw if it is not valid
+/////////////////////////////////////////////////////////
+void BmpImpl::ImportFrom( std::istream& is )
+{
+  Read( is );
+
+  if( is.fail() )
+    throw vp::Exception( "not a valid BMP file" );
 }
 
 ///////////////////////////////////////////////////////////////
@@ -94,6 +100,24 @@ bool BmpImpl::Export( const std::string& FileName, const bool OverWrite ) const
   return true;
 }
 
+//////////////////////////////////////////////
+// export to Data, which is replaced
+/////////////////////////////////////////////////////////
+void BmpImpl::ExportTo( std::vector<uint8_t>& Data ) const
+{
+  Data.clear();
+  VectorBuf Buffer( Data );
+  std::ostream os( &Buffer );
+
+  Write( os );
+}
+
+//////////////////////////////////////////////
+void BmpImpl::ExportTo( std::ostream& os ) const
+{
+  Write( os );
+}
+
 /////////////////////////////////////////////////////////////
 void BmpImpl::SetAllPixels( const uint8_t Blue, const uint8_t Green, const uint8_t Red )
 {
@@ -23,6 +23,7 @@
 #include <cstdint>
 #include <cstddef>  // size_t
 #include <string>
+#include <vector>
 
 #include "BmpInfo.h"
 #include "BmpFileHeader.h"
@@ -48,6 +49,12 @@ struct BmpImpl
   bool Import( const std::string& FileName );
   bool Export( const std::string& FileName, const bool OverWrite = false ) const;
 
+  // in-memory IO
+  void Import( const uint8_t* pData, const size_t Size );
+  void ImportFrom( std::istream& is );
+  void ExportTo( std::vector<uint8_t>& Data ) const;
+  void ExportTo( std::ostream& os ) const;
+
   // bpp
   uint8_t BitsPerPixel() const;
 
@@ -83,6 +83,13 @@ uint16_t Gif::Height() const
   return GetImpl()->Height();
 }
 
+/////////////////////////////////
+void Gif::CropAll( const uint16_t Left, const uint16_t Top,
+                   const uint16_t Width, const uint16_t Height )
+{
+  GetImpl()->CropAll( Left, Top, Width, Height );
+}
+
 /////////////////////////////////
 uint8_t Gif::BitsPerPixel() const
 {
@@ -178,9 +185,15 @@ bool Gif::Remove( const size_t Index )
 }
 
 //////////////////////////////////////////////
-bool Gif::Import( const std::string& FileName )
+bool Gif::OptimizeFrames()
+{
+  return GetImpl()->OptimizeFrames();
+}
+
+//////////////////////////////////////////////
+bool Gif::Import( const std::string& FileName, const bool Lazy )
 {
-  return GetImpl()->Import(FileName);
+  return GetImpl()->Import(FileName, Lazy);
 }
 
 ///////////////////////////////////////////////////////////////
@@ -189,6 +202,54 @@ bool Gif::Export( const std::string& FileName, const bool OverWrite )
   return GetImpl()->Export(FileName, OverWrite);
 }
 
+//////////////////////////////////////////////
+void Gif::Import( const uint8_t* Data, const size_t Size, const bool Lazy )
+{
+  GetImpl()->Import(Data, Size, Lazy);
+}
+
+//////////////////////////////////////////////
+void Gif::ImportFrom( std::istream& is, const bool Lazy )
+{
+  GetImpl()->ImportFrom(is, Lazy);
+}
+
+//////////////////////////////////////////////
+void Gif::ExportTo( std::vector<uint8_t>& Data )
+{
+  GetImpl()->ExportTo(Data);
+}
+
+//////////////////////////////////////////////
+void Gif::ExportTo( std::ostream& os )
+{
+  GetImpl()->ExportTo(os);
+}
+
+//////////////////////////////////////////////
+unsigned Gif::Threads() const
+{
+  return GetImpl()->Threads();
+}
+
+//////////////////////////////////////////////
+void Gif::Threads( const unsigned Count )
+{
+  GetImpl()->Threads(Count);
+}
+
+//////////////////////////////////////////////
+unsigned Gif::ImageThreads() const
+{
+  return GetImpl()->ImageThreads();
+}
+
+//////////////////////////////////////////////
+void Gif::ImageThreads( const unsigned Count )
+{
+  GetImpl()->ImageThreads(Count);
+}
+
 //////////////////
 size_t Gif::Size()
 {
@@ -102,6 +102,36 @@ namespace GifBlockIO
     }
   }
 
+  //////////////////////////////////
+  // Read a sub-block chain from stream into U8String as it is, i.e.
+  // including the size of each sub-block and the terminating byte,
+  // so that it can be decoded in place and written back unchanged
+  ///////////////////////////////////////////////////////////////////
+  inline void ReadRawSubBlocks( std::istream& is, U8String& String )
+  {
+    String.erase( String.begin(), String.end() );
+
+    while( true )
+    {
+      int BlockSize = is.get();
+      if( !is.good() )
+        return;  // truncated
+
+      String.push_back( static_cast<uint8_t>(BlockSize) );
+      if( BlockSize == 0 )
+        return;  // terminating byte
+
+      size_t Index = String.size();
+      String.resize( Index + static_cast<size_t>(BlockSize) );
+      is.read( reinterpret_cast<char*>(&String[Index]), BlockSize );
+      if( is.gcount() != BlockSize )
+      {
+        String.resize( Index + static_cast<size_t>(is.gcount()) );  // truncated
+        return;
+      }
+    }
+  }
+
   //////////////////////////////////
   // Write U8String or std::string into stream as a sub-block chain
   ///////////////////////////////////////////////////////////////////
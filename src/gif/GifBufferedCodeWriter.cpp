@@ -0,0 +1,129 @@
+////////////////////////////////////////////////////////////////////////
+// Copyright (C) 2019 Xueyi Yao
+//
+// This file is part of VPixels.
+//
+// VPixels is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+// 
+// VPixels is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+// 
+// You should have received a copy of the GNU General Public License
+// along with VPixels.  If not, see <https://www.gnu.org/licenses/>.
+////////////////////////////////////////////////////////////////////////
+
+#include "GifBufferedCodeWriter.h"
+#include <algorithm>
+
+namespace
+{
+  // load 8 bytes as uint64_t, little-endian, see GifSubBlockReader
+  inline uint64_t Load64( const uint8_t* p )
+  {
+    return  static_cast<uint64_t>(p[0])        | (static_cast<uint64_t>(p[1]) << 8)  |
+           (static_cast<uint64_t>(p[2]) << 16) | (static_cast<uint64_t>(p[3]) << 24) |
+           (static_cast<uint64_t>(p[4]) << 32) | (static_cast<uint64_t>(p[5]) << 40) |
+           (static_cast<uint64_t>(p[6]) << 48) | (static_cast<uint64_t>(p[7]) << 56);
+  }
+
+  // store uint64_t as 8 bytes, little-endian
+  // (compilers merge these into one store on little-endian machines)
+  inline void Store64( uint8_t* p, const uint64_t Word )
+  {
+    p[0] = static_cast<uint8_t>(Word);
+    p[1] = static_cast<uint8_t>(Word >> 8);
+    p[2] = static_cast<uint8_t>(Word >> 16);
+    p[3] = static_cast<uint8_t>(Word >> 24);
+    p[4] = static_cast<uint8_t>(Word >> 32);
+    p[5] = static_cast<uint8_t>(Word >> 40);
+    p[6] = static_cast<uint8_t>(Word >> 48);
+    p[7] = static_cast<uint8_t>(Word >> 56);
+  }
+}
+
+// caller's responsibility to initialize the string, codes are
+// appended to it. capacity reserved by caller is used up first.
+//////////////////////////////////////////
+GifBufferedCodeWriter::GifBufferedCodeWriter( U8String& CodeStr )
+ : m_CodeStr( CodeStr ),
+   m_Size( CodeStr.size() ),
+   m_BitCounter( 0 ),
+   m_Buffer( 0 )
+{
+  m_CodeStr.resize( m_Size + 8 );
+}
+
+/////////////////////////
+// store whole bytes in buffer into CodeStr
+/////////////////////////////////////////////////////////////
+void GifBufferedCodeWriter::Flush()
+{
+  // make sure there are 8 bytes available
+  if( m_Size + 8 > m_CodeStr.size() )
+    m_CodeStr.resize( std::max(m_Size + 8, 2*m_CodeStr.size()) );
+
+  // store all 8 bytes, but only whole bytes are counted.
+  // the last partial byte will be overwritten by next flush.
+  Store64( &m_CodeStr[m_Size], m_Buffer );
+
+  uint8_t Bytes = m_BitCounter >> 3;
+  m_Size += Bytes;
+  m_Buffer = (Bytes == 8) ? 0 : (m_Buffer >> (8*Bytes));
+  m_BitCounter = static_cast<uint8_t>(m_BitCounter - 8*Bytes);
+}
+
+/////////////////////////
+// write Bits bits of codes, packed into bytes as GifBufferedCodeWriter
+// writes them, e.g. the codes of a chunk encoded on its own
+/////////////////////////////////////////////////////////////
+void GifBufferedCodeWriter::Append( const uint8_t* pCodes, const size_t Bits )
+{
+  // fewer than 8 bits left in buffer, which are put in front of the
+  // codes, shifting them by the same number of bits
+  Flush();
+
+  // far from the end, store 8 bytes of codes at a time, the bits
+  // shifted out are carried over to the next 8 bytes
+  size_t Words = Bits / 64;
+  if( m_Size + 8*Words + 8 > m_CodeStr.size() )
+    m_CodeStr.resize( std::max(m_Size + 8*Words + 8, 2*m_CodeStr.size()) );
+
+  for( size_t i = 0; i < Words; ++i )
+  {
+    uint64_t Word = Load64( pCodes + 8*i );
+    Store64( &m_CodeStr[m_Size], m_Buffer | (Word << m_BitCounter) );
+    m_Buffer = (m_BitCounter == 0) ? 0 : (Word >> (64 - m_BitCounter));
+    m_Size += 8;
+  }
+
+  // whole bytes, then the bits left
+  size_t Bit = 64*Words;
+  for( ; Bits - Bit >= 8; Bit += 8 )
+    (*this)( pCodes[Bit/8], 8 );
+
+  if( Bit < Bits )
+    (*this)( static_cast<uint16_t>(pCodes[Bit/8] & ((1u << (Bits - Bit)) - 1)),
+             static_cast<uint8_t>(Bits - Bit) );
+}
+
+// end code writing
+void GifBufferedCodeWriter::End()
+{
+  Flush();
+
+  // the last partial byte
+  if( m_BitCounter > 0 )
+  {
+    ++m_Size;
+
+    m_Buffer = 0;
+    m_BitCounter = 0;
+  }
+
+  m_CodeStr.resize( m_Size );
+}
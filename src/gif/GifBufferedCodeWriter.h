@@ -0,0 +1,73 @@
+////////////////////////////////////////////////////////////////////////
+// Copyright (C) 2019 Xueyi Yao
+//
+// This file is part of VPixels.
+//
+// VPixels is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+// 
+// VPixels is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+// 
+// You should have received a copy of the GNU General Public License
+// along with VPixels.  If not, see <https://www.gnu.org/licenses/>.
+////////////////////////////////////////////////////////////////////////
+
+#ifndef GifBufferedCodeWriter_h
+#define GifBufferedCodeWriter_h
+
+#include <cstdint>
+#include "U8String.h"
+
+// Functor that write codes to string, same as GifCodeWriter.
+//
+// Codes are collected in a 64-bit buffer, which is stored into the
+// string 8 bytes at a time. The string is grown ahead of the codes
+// written, and trimmed by End(). Hence, unlike GifCodeWriter, the
+// content of the string is complete only after End() is called.
+//////////////////////////////////////////
+class GifBufferedCodeWriter
+{
+public:
+  explicit GifBufferedCodeWriter( U8String& CodeStr );
+  ~GifBufferedCodeWriter() = default;
+
+  // not implemented
+  GifBufferedCodeWriter( const GifBufferedCodeWriter& ) = delete;
+  GifBufferedCodeWriter( GifBufferedCodeWriter&& ) = delete;
+  GifBufferedCodeWriter& operator=( const GifBufferedCodeWriter& ) = delete;
+  GifBufferedCodeWriter& operator=( GifBufferedCodeWriter&& ) = delete;
+
+  void operator()( const uint16_t Code, const uint8_t CodeSize );
+  void Append( const uint8_t* pCodes, const size_t Bits );
+  void End();
+
+private:
+  void Flush();
+
+  U8String& m_CodeStr;    // encoded string
+  size_t    m_Size;       // number of bytes written to m_CodeStr
+  uint8_t   m_BitCounter; // number of bits in m_Buffer
+  uint64_t  m_Buffer;     // codes buffer, flushed when it can not
+                          // accommodate another 12-bit code
+};
+
+/////////////////////////
+// write Code of CodeSize (in bits) to CodeStr
+/////////////////////////////////////////////////////////////
+inline void GifBufferedCodeWriter::operator()( const uint16_t Code, const uint8_t CodeSize )
+{
+  // buffer the code
+  m_Buffer |= static_cast<uint64_t>(Code) << m_BitCounter;
+  m_BitCounter = static_cast<uint8_t>(m_BitCounter + CodeSize);
+
+  // flush whole bytes, if next code may not fit
+  if( m_BitCounter > 52 )
+    Flush();
+}
+
+#endif //GifBufferedCodeWriter_h
@@ -0,0 +1,58 @@
+////////////////////////////////////////////////////////////////////////
+// Copyright (C) 2019 Xueyi Yao
+//
+// This file is part of VPixels.
+//
+// VPixels is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+// 
+// VPixels is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+// 
+// You should have received a copy of the GNU General Public License
+// along with VPixels.  If not, see <https://www.gnu.org/licenses/>.
+////////////////////////////////////////////////////////////////////////
+
+#ifndef GifCodeCounter_h
+#define GifCodeCounter_h
+
+#include <cstdint>
+#include <cstddef>
+
+// Functor that counts the bits of codes instead of writing them.
+//
+// Size() is the number of bytes GifSubBlockWriter would write for
+// the same codes, i.e. the codes packed into sub-blocks of up to 255
+// bytes, each prefixed by its size, plus the terminating byte.
+//////////////////////////////////////////
+class GifCodeCounter
+{
+public:
+  GifCodeCounter() : m_Bits( 0 ) {}
+  ~GifCodeCounter() = default;
+
+  // not implemented
+  GifCodeCounter( const GifCodeCounter& ) = delete;
+  GifCodeCounter( GifCodeCounter&& ) = delete;
+  GifCodeCounter& operator=( const GifCodeCounter& ) = delete;
+  GifCodeCounter& operator=( GifCodeCounter&& ) = delete;
+
+  void operator()( const uint16_t, const uint8_t CodeSize ) { m_Bits += CodeSize; }
+  void Append( const uint8_t*, const size_t Bits ) { m_Bits += Bits; }
+  void End() {}
+
+  size_t Size() const
+  {
+    size_t Bytes = (m_Bits + 7) / 8;
+    return Bytes + (Bytes + 254) / 255 + 1;
+  }
+
+private:
+  size_t m_Bits;  // number of bits counted
+};
+
+#endif //GifCodeCounter_h
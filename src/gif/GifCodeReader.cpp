@@ -20,6 +20,19 @@
 #include "GifCodeReader.h"
 #include "Exception.h"
 
+namespace
+{
+  // load 8 bytes as uint64_t, little-endian
+  // (compilers merge these into one load on little-endian machines)
+  inline uint64_t Load64( const uint8_t* p )
+  {
+    return  static_cast<uint64_t>(p[0])        | (static_cast<uint64_t>(p[1]) << 8)  |
+           (static_cast<uint64_t>(p[2]) << 16) | (static_cast<uint64_t>(p[3]) << 24) |
+           (static_cast<uint64_t>(p[4]) << 32) | (static_cast<uint64_t>(p[5]) << 40) |
+           (static_cast<uint64_t>(p[6]) << 48) | (static_cast<uint64_t>(p[7]) << 56);
+  }
+}
+
 /////////////////////////////////////////
 GifCodeReader::GifCodeReader( const U8String& CodeStr )
  : m_CodeStr( CodeStr ),
@@ -32,27 +45,46 @@ GifCodeReader::GifCodeReader( const U8String& CodeStr )
 
 //////////////////////////
 // read a code of CodeSize (in bits) from CodeStr
+// throw if there are not enough bits left
 ///////////////////////////////////////////////////
 uint16_t GifCodeReader::operator()( const uint8_t CodeSize )
 {
-  // buffer the code
+  uint16_t Code;
+  if( !(*this)( CodeSize, Code ) )
+    throw vp::Exception( "no more code" );
+
+  return Code;
+}
+
+//////////////////////////
+// add bytes to buffer, so that it has at least CodeSize bits
+// return false if there are not enough bytes left
+///////////////////////////////////////////////////
+bool GifCodeReader::Refill( const uint8_t CodeSize )
+{
+  // far from the end, add as many whole bytes as the buffer can hold
+  // with a single 8-byte load
+  if( m_ByteIndex + 8 <= m_CodeStrSize )
+  {
+    uint8_t Bytes = static_cast<uint8_t>((64 - m_BitCounter) >> 3);
+    uint64_t Word = Load64( &m_CodeStr[m_ByteIndex] ) & (~0ULL >> (64 - 8*Bytes));
+
+    m_Buffer |= Word << m_BitCounter;
+    m_ByteIndex += Bytes;
+    m_BitCounter = static_cast<uint8_t>(m_BitCounter + 8*Bytes);
+    return true;
+  }
+
+  // near the end, add one byte at a time
   while( m_BitCounter < CodeSize )
   {
     if( m_ByteIndex >= m_CodeStrSize )
-      throw vp::Exception( "no more code" );
+      return false;
 
-    // add a byte to buffer
-    m_Buffer |= static_cast<uint32_t>(m_CodeStr[m_ByteIndex] << m_BitCounter);
+    m_Buffer |= static_cast<uint64_t>(m_CodeStr[m_ByteIndex]) << m_BitCounter;
     ++m_ByteIndex;
-    m_BitCounter += 8;
+    m_BitCounter = static_cast<uint8_t>(m_BitCounter + 8);
   }
 
-  // extract the code
-  uint16_t Code = m_Buffer & static_cast<uint32_t>(0xFFFF >> (16 - CodeSize));
-
-  // update buffer
-  m_Buffer >>= CodeSize;
-  m_BitCounter -= CodeSize;
-
-  return Code;
+  return true;
 }
@@ -38,14 +38,37 @@ public:
   GifCodeReader& operator=( GifCodeReader&& ) = delete;
 
   uint16_t operator()( const uint8_t CodeSize );
+  bool     operator()( const uint8_t CodeSize, uint16_t& Code );
 
 private:
+  bool Refill( const uint8_t CodeSize );
+
   const U8String& m_CodeStr;  // encoded string
   size_t   m_CodeStrSize;     // size of m_CodeStr
   size_t   m_ByteIndex;       // index to next byte in m_CodeStr
   uint8_t  m_BitCounter;      // number of bits in m_Buffer
-  uint32_t m_Buffer;          // codes buffer, need 32-bit to accommodate
-                              // two more bytes while 3 bits are left
+  uint64_t m_Buffer;          // codes buffer, refilled with as many bytes
+                              // as it can hold, bits above m_BitCounter are 0
 };
 
+//////////////////////////
+// read a code of CodeSize (in bits) from CodeStr
+// return false if there are not enough bits left
+///////////////////////////////////////////////////
+inline bool GifCodeReader::operator()( const uint8_t CodeSize, uint16_t& Code )
+{
+  // buffer the code
+  if( m_BitCounter < CodeSize && !Refill( CodeSize ) )
+    return false;
+
+  // extract the code
+  Code = static_cast<uint16_t>(m_Buffer & (0xFFFFu >> (16 - CodeSize)));
+
+  // update buffer
+  m_Buffer >>= CodeSize;
+  m_BitCounter = static_cast<uint8_t>(m_BitCounter - CodeSize);
+
+  return true;
+}
+
 #endif //GifCodeReader_h
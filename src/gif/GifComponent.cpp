@@ -23,6 +23,7 @@
 #include "GifGraphicsControlExt.h"
 #include "GifImageDescriptor.h"
 #include "GifPlainTextExt.h"
+#include <sstream>
 
 //////////////////////////////////////////////////
 std::shared_ptr<GifComponent> GifComponent::Create( const uint8_t Label )
@@ -65,3 +66,14 @@ GifComponent::Create( const uint8_t BitsPerPixel,
   return std::shared_ptr<GifComponent>( new GifImageDescriptor(BitsPerPixel, Width, Height,
                                                                Left, Top, LocalColorTable) );
 }
+
+///////////////////
+// Components other than GifImageDescriptor are small, simply write them
+////////////////////////////////////////////////////////
+size_t GifComponent::Size() const
+{
+  std::ostringstream os;
+  Write( os );
+
+  return static_cast<size_t>( os.tellp() );
+}
@@ -61,6 +61,9 @@ public:
   virtual void Read( std::istream& ) = 0;
   virtual void Write( std::ostream& ) const = 0;
 
+  // number of bytes written by Write()
+  virtual size_t Size() const;
+
 protected:
   // use factory method to instantiate GifComponent's subclasses
   explicit GifComponent( uint8_t ID ) : m_ID( ID ) {}
@@ -146,3 +146,15 @@ void GifComponentVecUtil::Write( std::ostream& os, GifComponentVec& ComponentVec
   for( auto& pComponent : ComponentVec )
     pComponent->Write( os );
 }
+
+////////////////////////////////////////////////////////////
+size_t GifComponentVecUtil::Size( GifComponentVec& ComponentVec )
+{
+  AddComment( ComponentVec );
+
+  size_t Size = 0;
+  for( auto& pComponent : ComponentVec )
+    Size += pComponent->Size();
+
+  return Size;
+}
@@ -42,6 +42,9 @@ namespace GifComponentVecUtil
 
   // write GifComponentVec to stream
   void Write( std::ostream&, GifComponentVec& );
+
+  // number of bytes written by Write()
+  size_t Size( GifComponentVec& );
 }
 
 #endif //GifComponentVecUtil_h
@@ -49,16 +49,9 @@ void GifDecoder::operator()( const uint8_t Bpp, const U8String& CodeStr, U8Strin
     {
       InitParameters();
 
-      // read a code
-      try
-      {
-        Code = ReadCode( m_CodeSize );    
-      }
-      catch( const vp::Exception& )
-      {
-        // hit the end while EOIcode is absent
+      // read a code, in case of hitting the end while EOIcode is absent
+      if( !ReadCode( m_CodeSize, Code ) )
         Code = EOICode;
-      }
 
       // in case that EOICode follows right after ClearCode
       if( Code == EOICode )
@@ -105,15 +98,8 @@ void GifDecoder::operator()( const uint8_t Bpp, const U8String& CodeStr, U8Strin
 
     // next code
     PrevCode = Code;
-    try
-    {
-      Code = ReadCode( m_CodeSize );    
-    }
-    catch( const vp::Exception& )
-    {
-      // hit the end while EOIcode is absent
-      Code = EOICode;
-    }
+    if( !ReadCode( m_CodeSize, Code ) )
+      Code = EOICode;  // hit the end while EOIcode is absent
   }
 }
 
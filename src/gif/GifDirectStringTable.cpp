@@ -0,0 +1,59 @@
+////////////////////////////////////////////////////////////////////////
+// Copyright (C) 2019 Xueyi Yao
+//
+// This file is part of VPixels.
+//
+// VPixels is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+// 
+// VPixels is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+// 
+// You should have received a copy of the GNU General Public License
+// along with VPixels.  If not, see <https://www.gnu.org/licenses/>.
+////////////////////////////////////////////////////////////////////////
+
+#include "GifDirectStringTable.h"
+#include <algorithm>
+
+/////////////////
+GifDirectStringTable::GifDirectStringTable()
+ : m_pCode( nullptr ),
+   m_Size( 0 ),
+   m_Bpp( 0 ),
+   m_PixelMask( 0 ),
+   m_End( 0 ),
+   m_Key()
+{
+}
+
+//////////////////
+// allocate entries for Bpp, and reset table
+//
+// entries are zeroed once when allocated, so that searching never
+// reads an indeterminate code; stale codes are validated against
+// m_End and m_Key
+//////////////////////////////////////////////////////////
+void GifDirectStringTable::Init( const uint8_t Bpp )
+{
+  uint32_t Size = static_cast<uint32_t>(4096) << Bpp;
+  if( Size > m_Size )
+  {
+    m_pCode.reset( new uint16_t[Size]() );
+    m_Size = Size;
+  }
+
+  // codes added under a different bpp may now be pixels, invalidate them.
+  // no code represents key 0xFFFFFFFF, as pixel and string are at most
+  // 8-bit and 12-bit respectively
+  if( Bpp != m_Bpp )
+    std::fill_n( m_Key, 4096, 0xFFFFFFFF );
+
+  m_Bpp = Bpp;
+  m_PixelMask = static_cast<uint8_t>((1 << Bpp) - 1);
+  Reset();
+}
@@ -0,0 +1,105 @@
+////////////////////////////////////////////////////////////////////////
+// Copyright (C) 2019 Xueyi Yao
+//
+// This file is part of VPixels.
+//
+// VPixels is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+// 
+// VPixels is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+// 
+// You should have received a copy of the GNU General Public License
+// along with VPixels.  If not, see <https://www.gnu.org/licenses/>.
+////////////////////////////////////////////////////////////////////////
+
+#ifndef GifDirectStringTable_h
+#define GifDirectStringTable_h
+
+#include <cstdint>
+#include <memory>
+
+// A string table used by Encoder to search for string + pixel pair,
+// an alternative to GifStringTable.
+//
+// The code of string + pixel is stored at [string][pixel] of a table of
+// 4096 x 2^bpp entries, so that searching does not need probing. An entry
+// is valid only if its code has been added since last reset, and the code
+// still represents the same string + pixel. Hence, the table does not need
+// to be initialized, and resetting it does not touch the entries.
+//
+// Codes are supposed to be added in increasing order, starting from
+// the first code after clear code and EOI code, as Encoder does.
+/////////////////////////////////////////////////////////////////
+class GifDirectStringTable
+{
+public:
+  typedef uint32_t IndexType;
+
+  GifDirectStringTable();
+  ~GifDirectStringTable() = default;
+
+  // not implemented
+  GifDirectStringTable( const GifDirectStringTable& ) = delete;
+  GifDirectStringTable( GifDirectStringTable&& ) = delete;
+  GifDirectStringTable& operator=( const GifDirectStringTable& ) = delete;
+  GifDirectStringTable& operator=( GifDirectStringTable&& ) = delete;
+
+  void Init( const uint8_t Bpp );
+  void Reset() { m_End = 0; }
+
+  uint16_t Search( const uint16_t String, const uint8_t Pixel, IndexType& Index ) const;
+  void     Add( const IndexType Index, const uint16_t String, const uint8_t Pixel,
+                const uint16_t Code );
+
+private:
+  static uint32_t Key( const uint16_t String, const uint8_t Pixel )
+  {
+    return static_cast<uint32_t>(String << 8) | Pixel;
+  }
+
+  // member data
+  std::unique_ptr<uint16_t[]> m_pCode;  // code of string + pixel
+  uint32_t m_Size;          // number of entries of m_pCode
+  uint8_t  m_Bpp;           // bits per pixel
+  uint8_t  m_PixelMask;     // bits of pixel used as index
+  uint16_t m_End;           // codes below it have been added since reset
+  uint32_t m_Key[4096];     // string + pixel that a code represents
+};
+
+//////////////////////
+// Search for code of String + Pixel
+//
+// if String + Pixel are not in table, Index points to the entry
+// for adding them and their corresponding Code
+//////////////////////////////////////////////////////////////
+inline uint16_t GifDirectStringTable::Search( const uint16_t String, const uint8_t Pixel,
+                                              IndexType& Index ) const
+{
+  Index = (static_cast<uint32_t>(String) << m_Bpp) | (Pixel & m_PixelMask);
+  uint16_t Code = m_pCode[Index];
+  if( Code < m_End && m_Key[Code] == Key( String, Pixel ) )
+    return Code;
+
+  // failed to find code
+  return 0;
+}
+
+///////////////////
+// Add Code for String + Pixel to the given Index
+// call Search() to get Index.
+///////////////////////////////////////////////////////////////
+inline void GifDirectStringTable::Add( const IndexType Index, const uint16_t String,
+                                       const uint8_t Pixel, const uint16_t Code )
+{
+  m_pCode[Index] = Code;
+  m_Key[Code] = Key( String, Pixel );
+  if( Code >= m_End )
+    m_End = Code + 1;
+}
+
+#endif //GifDirectStringTable_h
@@ -22,16 +22,39 @@
 
 #include <cstdint>
 #include "U8String.h"
-#include "GifCodeWriter.h"
 #include "GifStringTable.h"
+#include "GifDirectStringTable.h"
+
+// string table used by GifEncoder
+//   Hashed: GifStringTable, small and cheap to set up
+//   Direct: GifDirectStringTable, no probing, but 4096 x 2^bpp entries
+//   Auto:   Direct, faster for all bpp; Hashed uses less memory
+enum class GifDictionary : uint8_t { Auto, Hashed, Direct };
+
+class GifSubBlockWriter;
+class GifCodeCounter;
 
 // LZW encoding
-// Functor that encodes pixels(bytes) into codes.
+// Functor that encodes pixels(bytes) into codes, which are written
+// either to a string, or as a sub-block chain by GifSubBlockWriter,
+// or only counted by GifCodeCounter.
+//
+// With Threads other than 1 (0 means one per hardware thread), pixels
+// of a large image are split into chunks of at least MinChunk pixels,
+// which are encoded on their own threads and joined by clear codes.
+// Any decoder reads the result, but it is not identical to the codes
+// encoded in one piece, and larger, as each chunk restarts the string
+// table: hardly for detailed images, but by up to tens of percent for
+// flat ones that compress well, see "split" of GifBenchmark. MinChunk
+// is large enough that small and medium images are never split.
 /////////////////////////////////////////////////
 class GifEncoder
 {
 public:
-  GifEncoder() = default;
+  static constexpr size_t MinChunk = 1 << 20;
+
+  explicit GifEncoder( const GifDictionary Dictionary = GifDictionary::Auto,
+                       const unsigned Threads = 1 );
   ~GifEncoder() = default;
 
   // not implemented
@@ -41,8 +64,19 @@ public:
   GifEncoder& operator=( GifEncoder&& ) = delete;
 
   void operator()( const uint8_t Bpp, const U8String&, U8String& );
+  void operator()( const uint8_t Bpp, const U8String&, GifSubBlockWriter& );
+  void operator()( const uint8_t Bpp, const U8String&, GifCodeCounter& );
 
 private:
+  template<typename CodeWriter>
+  void EncodeTo( const uint8_t Bpp, const U8String&, CodeWriter& );
+  template<typename CodeWriter>
+  void EncodeChunks( const uint8_t Bpp, const U8String&, const size_t Chunks, CodeWriter& );
+  template<typename CodeWriter>
+  void EncodeWith( const uint8_t*, const size_t, const bool First, const bool Last, CodeWriter& );
+  template<typename StringTable, typename CodeWriter>
+  void Encode( StringTable&, const uint8_t*, const size_t, const bool First, const bool Last, CodeWriter& );
+
   void InitConstants( const uint8_t Bpp );
   void InitParameters();
   void UpdateParameters();
@@ -57,7 +91,11 @@ private:
   uint16_t m_FreeCode;     // next available code 
 
   // string table
-  GifStringTable m_StringTable;
+  GifDictionary        m_Dictionary;
+  GifStringTable       m_StringTable;
+  GifDirectStringTable m_DirectStringTable;
+
+  unsigned m_Threads;      // threads to encode chunks of pixels
 };
 
 #endif //GifEncoder_h
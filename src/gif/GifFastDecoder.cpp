@@ -0,0 +1,203 @@
+////////////////////////////////////////////////////////////////////////
+// Copyright (C) 2019 Xueyi Yao
+//
+// This file is part of VPixels.
+//
+// VPixels is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+// 
+// VPixels is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+// 
+// You should have received a copy of the GNU General Public License
+// along with VPixels.  If not, see <https://www.gnu.org/licenses/>.
+////////////////////////////////////////////////////////////////////////
+
+#include "GifFastDecoder.h"
+#include "GifCodeReader.h"
+#include "GifSubBlockReader.h"
+#include "Exception.h"
+#include <algorithm>
+#include <cstring>
+
+////////////////////////
+// Decode codes into pixel bytes.
+// Caller is responsible for initialization of PixelStr. Decoded pixels
+// are appended to PixelStr, whose capacity, if reserved by caller, is
+// used as the initial size of the output buffer.
+//////////////////////////////////////////////////////////////////////////////
+void GifFastDecoder::operator()( const uint8_t Bpp, const U8String& CodeStr, U8String& PixelStr )
+{
+  InitConstants( Bpp );
+  GifCodeReader ReadCode( CodeStr );
+  Decode( ReadCode, PixelStr );
+}
+
+////////////////////////
+// Decode codes read from a sub-block chain into pixel bytes.
+// Same as above, ReadCode is left at where decoding stops.
+//////////////////////////////////////////////////////////////////////////////
+void GifFastDecoder::operator()( const uint8_t Bpp, GifSubBlockReader& ReadCode, U8String& PixelStr )
+{
+  InitConstants( Bpp );
+  Decode( ReadCode, PixelStr );
+}
+
+////////////////////////
+// LZW decoding using either of the code readers
+//////////////////////////////////////////////////////////////////////////////
+template<typename CodeReader>
+void GifFastDecoder::Decode( CodeReader& ReadCode, U8String& PixelStr )
+{
+  // initialization
+  InitParameters();
+
+  // 1st code must be ClearCode
+  uint16_t Code = ReadCode( m_CodeSize );
+  if( Code != m_ClearCode )
+    VP_THROW( "not a clear code, data may be corrupted" );
+
+  // write pixels directly into output buffer, which is trimmed when done
+  size_t Pos = PixelStr.size();
+  uint8_t* pOut = Reserve( PixelStr, PixelStr.capacity() );
+
+  // string that previous code represents
+  size_t   PrevOffset = 0;
+  uint16_t PrevLength = 0;
+  uint8_t  PrevFirst  = 0;
+
+  uint16_t EOICode = m_ClearCode + 1;  // End-Of-Information code 
+  while( Code != EOICode )
+  {
+    if( Code == m_ClearCode ) //If it's a clear code
+    {
+      InitParameters();
+
+      // read a code, in case of hitting the end while EOIcode is absent
+      if( !ReadCode( m_CodeSize, Code ) )
+        Code = EOICode;
+
+      // in case that EOICode follows right after ClearCode
+      if( Code == EOICode )
+        break;
+
+      // 1st code following ClearCode must be a pixel
+      if( Code >= m_ClearCode )
+        VP_THROW( "not a pixel, data may be corrupted" );
+
+      if( Pos + 1 > PixelStr.size() )
+        pOut = Reserve( PixelStr, Pos + 1 );
+
+      PrevOffset = Pos;
+      PrevLength = 1;
+      PrevFirst  = static_cast<uint8_t>(Code);
+      pOut[Pos++] = PrevFirst;
+    } 
+    else
+    {
+      size_t   Offset = Pos;
+      uint16_t Length;
+      uint8_t  FirstPixel;
+      if( Code < m_ClearCode ) // current code is a pixel
+      {
+        Length = 1;
+        FirstPixel = static_cast<uint8_t>(Code);
+        if( Pos + Length > PixelStr.size() )
+          pOut = Reserve( PixelStr, Pos + Length );
+
+        pOut[Pos] = FirstPixel;
+      }
+      else if( Code < m_FreeCode ) // current code is in string table
+      {
+        Length = m_Length[Code];
+        FirstPixel = m_First[Code];
+        if( Pos + Length > PixelStr.size() )
+          pOut = Reserve( PixelStr, Pos + Length );
+
+        // the string was output before and does not overlap with Pos
+        std::memcpy( pOut + Pos, pOut + m_Offset[Code], Length );
+      }
+      else // string of previous code + its 1st pixel
+      {
+        Length = PrevLength + 1;
+        FirstPixel = PrevFirst;
+        if( Pos + Length > PixelStr.size() )
+          pOut = Reserve( PixelStr, Pos + Length );
+
+        std::memcpy( pOut + Pos, pOut + PrevOffset, PrevLength );
+        pOut[Pos + PrevLength] = FirstPixel;
+      }
+      Pos += Length;
+
+      // see GifDecoder for the reason of this verification
+      if( m_FreeCode < 4096 )
+      {
+        // add string + pixel to string table. the new string
+        // starts where the string of previous code was output
+        m_Offset[m_FreeCode] = PrevOffset;
+        m_Length[m_FreeCode] = PrevLength + 1;
+        m_First[m_FreeCode]  = PrevFirst;
+        ++m_FreeCode;
+      }
+
+      PrevOffset = Offset;
+      PrevLength = Length;
+      PrevFirst  = FirstPixel;
+    }
+
+    // increase code size
+    if( m_FreeCode == m_CodeLimit && m_CodeSize < 12 ) 
+    {
+      ++m_CodeSize;
+      m_CodeLimit <<= 1;
+    }
+
+    // next code
+    if( !ReadCode( m_CodeSize, Code ) )
+      Code = EOICode;  // hit the end while EOIcode is absent
+  }
+
+  // trim output buffer
+  PixelStr.resize( Pos );
+}
+
+//////////////////////////////////
+// Initialize constants that depend on Bpp
+// see GifDecoder::InitConstants()
+////////////////////////////////////////////////////////
+void GifFastDecoder::InitConstants( const uint8_t Bpp )
+{
+  m_InitCodeSize = Bpp + 1;  
+  m_ClearCode = 1 << Bpp; 
+}
+
+/////////////////////////
+// Initialize dynamic parameters that change during decoding
+//////////////////////////////////////////////////////////
+void GifFastDecoder::InitParameters()
+{
+  m_CodeSize  = m_InitCodeSize;
+  m_CodeLimit = 1 << m_InitCodeSize;
+  m_FreeCode  = m_ClearCode + 2;  // initialize string table
+}
+
+///////////////////
+// Grow output buffer to accommodate at least Size pixels.
+// Return pointer to the buffer, which may have been reallocated.
+///////////////////////////////////////////////////////////////
+uint8_t* GifFastDecoder::Reserve( U8String& PixelStr, const size_t Size )
+{
+  size_t NewSize = PixelStr.size();
+  if( NewSize < Size )
+  {
+    // grow by 4096 (the longest string is shorter than that) or doubling
+    NewSize = std::max( Size, NewSize + std::max(NewSize, static_cast<size_t>(4096)) );
+    PixelStr.resize( NewSize );
+  }
+
+  return &PixelStr[0];
+}
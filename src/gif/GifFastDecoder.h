@@ -0,0 +1,77 @@
+////////////////////////////////////////////////////////////////////////
+// Copyright (C) 2019 Xueyi Yao
+//
+// This file is part of VPixels.
+//
+// VPixels is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+// 
+// VPixels is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+// 
+// You should have received a copy of the GNU General Public License
+// along with VPixels.  If not, see <https://www.gnu.org/licenses/>.
+////////////////////////////////////////////////////////////////////////
+
+#ifndef GifFastDecoder_h
+#define GifFastDecoder_h
+
+#include <cstdint>
+#include "U8String.h"
+
+class GifSubBlockReader;
+
+// LZW decoding
+// Functor that decodes codes into pixels(bytes), same as GifDecoder.
+//
+// Instead of walking the prefix chain of a code, it records where the
+// string of each code was output and its length. As the string of a
+// code is always a prefix of pixels that have already been output,
+// decoding a code is a single copy within the output. GifDecoder is kept
+// as the reference implementation.
+//
+// Codes are read either from a string, or straight from a sub-block
+// chain by GifSubBlockReader.
+/////////////////////////////////////////////////
+class GifFastDecoder
+{
+public:
+  GifFastDecoder()  = default;
+  ~GifFastDecoder() = default;
+
+  // not implemented
+  GifFastDecoder( const GifFastDecoder& ) = delete;
+  GifFastDecoder( GifFastDecoder&& ) = delete;
+  GifFastDecoder& operator=( const GifFastDecoder& ) = delete;
+  GifFastDecoder& operator=( GifFastDecoder&& ) = delete;
+
+  void operator()( const uint8_t Bpp, const U8String&, U8String& );
+  void operator()( const uint8_t Bpp, GifSubBlockReader&, U8String& );
+
+private:
+  template<typename CodeReader>
+  void     Decode( CodeReader& ReadCode, U8String& PixelStr );
+  void     InitConstants( const uint8_t Bpp );
+  void     InitParameters();
+  uint8_t* Reserve( U8String& PixelStr, const size_t Size );
+
+  // constants to certain bpp
+  uint16_t m_ClearCode;    // clear code, max value 256 when bpp=8
+  uint8_t  m_InitCodeSize; // initial code size
+
+  // dynamic parameters
+  uint8_t  m_CodeSize;     // current code size in bits, max 12 bits
+  uint16_t m_CodeLimit;    // upper bound of code under current code size
+  uint16_t m_FreeCode;     // next available code 
+
+  // string table
+  size_t   m_Offset[4096]; // where the string was output
+  uint16_t m_Length[4096]; // length of the string
+  uint8_t  m_First[4096];  // 1st pixel of the string
+};
+
+#endif //GifFastDecoder_h
@@ -0,0 +1,124 @@
+////////////////////////////////////////////////////////////////////////
+// Copyright (C) 2019 Xueyi Yao
+//
+// This file is part of VPixels.
+//
+// VPixels is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+// 
+// VPixels is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+// 
+// You should have received a copy of the GNU General Public License
+// along with VPixels.  If not, see <https://www.gnu.org/licenses/>.
+////////////////////////////////////////////////////////////////////////
+
+#ifndef GifFrameDiff_h
+#define GifFrameDiff_h
+
+#include <cstdint>
+#include <cstddef>
+#include <cstring>
+
+//////////////////////////////
+// Comparison of rows of two rendered frames, RGBA, 4 bytes per pixel.
+// Pixels are compared 4 at a time as pairs of 64-bit words, and the
+// loops over whole rows are free of branches, so that they compile
+// into vector instructions.
+////////////////////////////////////////////////////////////////
+namespace GifFrameDiff
+{
+  //////////////////////////////////
+  // whether 4 pixels from pA and pB differ
+  ////////////////////////////////////////////////////////////
+  inline bool Differ4( const uint8_t* pA, const uint8_t* pB )
+  {
+    uint64_t a[2], b[2];
+    std::memcpy( a, pA, 16 );
+    std::memcpy( b, pB, 16 );
+    return ((a[0] ^ b[0]) | (a[1] ^ b[1])) != 0;
+  }
+
+  //////////////////////////////////
+  // whether pixel X of pA and pB differ
+  ////////////////////////////////////////////////////////////
+  inline bool Differ( const uint8_t* pA, const uint8_t* pB, const size_t X )
+  {
+    uint32_t a, b;
+    std::memcpy( &a, pA + 4*X, 4 );
+    std::memcpy( &b, pB + 4*X, 4 );
+    return a != b;
+  }
+
+  //////////////////////////////////
+  // first pixel where rows pA and pB of Width pixels differ,
+  // or Width if none
+  ////////////////////////////////////////////////////////////
+  inline size_t First( const uint8_t* pA, const uint8_t* pB, const size_t Width )
+  {
+    size_t X = 0;
+    while( X + 4 <= Width && !Differ4( pA + 4*X, pB + 4*X ) )
+      X += 4;
+
+    while( X < Width && !Differ( pA, pB, X ) )
+      ++X;
+
+    return X;
+  }
+
+  //////////////////////////////////
+  // one past the last pixel where rows pA and pB of Width pixels
+  // differ, or 0 if none
+  ////////////////////////////////////////////////////////////
+  inline size_t Last( const uint8_t* pA, const uint8_t* pB, const size_t Width )
+  {
+    size_t X = Width;
+    while( X >= 4 && !Differ4( pA + 4*(X - 4), pB + 4*(X - 4) ) )
+      X -= 4;
+
+    while( X > 0 && !Differ( pA, pB, X - 1 ) )
+      --X;
+
+    return X;
+  }
+
+  //////////////////////////////////
+  // whether no pixel of Width that differs between rows pA and pB
+  // is Trans in pIndices
+  ////////////////////////////////////////////////////////////
+  inline bool Covers( const uint8_t* pA, const uint8_t* pB, const uint8_t* pIndices,
+                      const size_t Width, const uint8_t Trans )
+  {
+    unsigned Uncovered = 0;
+    for( size_t X = 0; X < Width; ++X )
+      Uncovered |= static_cast<unsigned>(Differ( pA, pB, X )) &
+                   static_cast<unsigned>(pIndices[X] == Trans);
+
+    return Uncovered == 0;
+  }
+
+  //////////////////////////////////
+  // set pIndices to Trans where rows pA and pB of Width pixels are
+  // the same, return the number of pixels set
+  ////////////////////////////////////////////////////////////
+  inline size_t Mark( const uint8_t* pA, const uint8_t* pB, uint8_t* pIndices,
+                      const size_t Width, const uint8_t Trans )
+  {
+    size_t Marked = 0;
+    for( size_t X = 0; X < Width; ++X )
+    {
+      bool Set = !Differ( pA, pB, X ) & (pIndices[X] != Trans);
+      pIndices[X] = Set? Trans : pIndices[X];
+      Marked += Set;
+    }
+
+    return Marked;
+  }
+
+} // namespace GifFrameDiff
+
+#endif //GifFrameDiff_h
@@ -52,6 +52,12 @@ bool GifImage::operator!=( const GifImage& other ) const
   return !(*m_pImpl == *other.m_pImpl);
 }
 
+///////////////////////////////////////////////
+uint64_t GifImage::Hash() const
+{
+  return GetImpl()->Hash();
+}
+
 //////////////////////
 uint8_t GifImage::BitsPerPixel() const
 {
@@ -139,6 +145,12 @@ bool GifImage::Interlaced() const
   return GetImpl()->Interlaced();
 }
 
+/////////////////////////
+void GifImage::Interlaced( const bool Interlace )
+{
+  GetImpl()->Interlaced( Interlace );
+}
+
 /////////////////////////////////////////
 void GifImage::SetAllPixels( const uint8_t ColorIndex )
 {
@@ -170,6 +182,68 @@ bool GifImage::Transparent( const uint16_t X, const uint16_t Y ) const
   return GetImpl()->Transparent( X, Y );
 }
 
+//////////////////////////////////////////////////////////////////////
+void GifImage::SetRow( const uint16_t Y, const uint8_t* Indices )
+{
+  GetImpl()->SetRow( Y, Indices );
+}
+
+////////////////////////////////////////////////////////////////
+void GifImage::GetRow( const uint16_t Y, uint8_t* Indices ) const
+{
+  GetImpl()->GetRow( Y, Indices );
+}
+
+//////////////////////////////////////////////////////////////////////
+void GifImage::SetRect( const uint16_t X, const uint16_t Y,
+                        const uint16_t Width, const uint16_t Height,
+                        const uint8_t* Indices )
+{
+  GetImpl()->SetRect( X, Y, Width, Height, Indices );
+}
+
+////////////////////////////////////////////////////////////////
+void GifImage::GetRect( const uint16_t X, const uint16_t Y,
+                        const uint16_t Width, const uint16_t Height,
+                        uint8_t* Indices ) const
+{
+  GetImpl()->GetRect( X, Y, Width, Height, Indices );
+}
+
+////////////////////////////////////////////////////////////////
+const uint8_t* GifImage::Data() const
+{
+  return GetImpl()->Data();
+}
+
+////////////////////////////////////////////////////////////////
+void GifImage::GetRGB( uint8_t* RGB ) const
+{
+  GetImpl()->GetRGB( 0, 0, Width(), Height(), RGB );
+}
+
+////////////////////////////////////////////////////////////////
+void GifImage::GetRGBA( uint8_t* RGBA ) const
+{
+  GetImpl()->GetRGBA( 0, 0, Width(), Height(), RGBA );
+}
+
+////////////////////////////////////////////////////////////////
+void GifImage::GetRGB( const uint16_t X, const uint16_t Y,
+                       const uint16_t Width, const uint16_t Height,
+                       uint8_t* RGB ) const
+{
+  GetImpl()->GetRGB( X, Y, Width, Height, RGB );
+}
+
+////////////////////////////////////////////////////////////////
+void GifImage::GetRGBA( const uint16_t X, const uint16_t Y,
+                        const uint16_t Width, const uint16_t Height,
+                        uint8_t* RGBA ) const
+{
+  GetImpl()->GetRGBA( X, Y, Width, Height, RGBA );
+}
+
 /////////////////////////////////////////////
 void GifImage::Delay( uint16_t Centisecond )
 {
@@ -19,26 +19,73 @@
 
 #include "GifImageData.h"
 #include "GifEncoder.h"
-#include "GifDecoder.h"
+#include "GifFastDecoder.h"
+#include "GifSubBlockReader.h"
+#include "GifSubBlockWriter.h"
+#include "GifCodeCounter.h"
 #include "GifBlockIO.h"
+#include "GifInterlace.h"
 #include "IOutil.h"
+#include "MemoryBuf.h"
 #include "Exception.h"
+#include <cstring>
 #include <istream>
 
+namespace
+{
+  const uint64_t Multiplier = 0x9E3779B97F4A7C15ull;
+
+  ////////////////////
+  inline uint64_t Mix( const uint64_t Hash, const uint64_t Word )
+  {
+    return ((Hash << 29 | Hash >> 35) ^ Word)*Multiplier;
+  }
+
+  ////////////////////
+  inline uint64_t Finish( uint64_t Hash )
+  {
+    Hash ^= Hash >> 32;
+    Hash *= Multiplier;
+    return Hash ^ (Hash >> 29);
+  }
+}
+
 //////////////////////////////////////////////////////////////////////
 GifImageData::GifImageData( const uint8_t BitsPerPixel, const uint32_t Size )
  : m_BitsPerPixel( BitsPerPixel ),
-   m_Pixels( U8String() )  // initial size is zero
+   m_Pixels( U8String() ),  // initial size is zero
+   m_Encoded(),
+   m_Capacity( 0 ),
+   m_Pending( false ),
+   m_EncodedSize( 0 ),
+   m_Hash( 0 ),
+   m_PaletteHash( 0 ),
+   m_Hashed( false ),
+   m_InterlacedWidth( 0 ),
+   m_Mutex()
 {
   if( Size != 0)
     m_Pixels.resize( Size );  // resize() zero-initializes all elements
 }
 
+////////////////////////////////////////////
+// other may be decoding or hashing in another thread, its members
+// are copied under its lock
 ////////////////////////////////////////////
 GifImageData::GifImageData( const GifImageData& other )
- : m_BitsPerPixel( other.m_BitsPerPixel ),
-   m_Pixels( other.m_Pixels )
+ : m_BitsPerPixel( 0 ),
+   m_Pixels(),
+   m_Encoded(),
+   m_Capacity( 0 ),
+   m_Pending( false ),
+   m_EncodedSize( 0 ),
+   m_Hash( 0 ),
+   m_PaletteHash( 0 ),
+   m_Hashed( false ),
+   m_InterlacedWidth( 0 ),
+   m_Mutex()
 {
+  *this = other;
 }
 
 ////////////////////////////////////////////////////////
@@ -46,8 +93,20 @@ GifImageData& GifImageData::operator=( const GifImageData& other )
 {
   if( this != &other )
   {
+    std::unique_lock<std::mutex> Lock( m_Mutex, std::defer_lock );
+    std::unique_lock<std::mutex> OtherLock( other.m_Mutex, std::defer_lock );
+    std::lock( Lock, OtherLock );
+
     m_BitsPerPixel = other.m_BitsPerPixel;
     m_Pixels = other.m_Pixels;
+    m_Encoded = other.m_Encoded;
+    m_Capacity = other.m_Capacity;
+    m_Pending = other.m_Pending.load();
+    m_EncodedSize = other.m_EncodedSize;
+    m_Hash = other.m_Hash;
+    m_PaletteHash = other.m_PaletteHash;
+    m_Hashed = other.m_Hashed;
+    m_InterlacedWidth = other.m_InterlacedWidth;
   }
 
   return *this;
@@ -60,31 +119,103 @@ GifImageData& GifImageData::operator=( GifImageData&& other ) noexcept
   {
     m_BitsPerPixel = other.m_BitsPerPixel;  // uint8_t, don't need to call move()
     m_Pixels = std::move(other.m_Pixels);
+    m_Encoded = std::move(other.m_Encoded);
+    m_Capacity = other.m_Capacity;
+    m_Pending = other.m_Pending.load();
+    m_EncodedSize = other.m_EncodedSize;
+    m_Hash = other.m_Hash;
+    m_PaletteHash = other.m_PaletteHash;
+    m_Hashed = other.m_Hashed;
+    m_InterlacedWidth = other.m_InterlacedWidth;
   }
 
   return *this;
 }
 
+///////////////////////////////////////
+// bpp or pixels changed, so the original sub-blocks and the
+// counted size are no longer valid
+///////////////////////////////////////
+void GifImageData::Modified()
+{
+  if( !m_Encoded.empty() )
+    U8String().swap( m_Encoded );  // release memory
+
+  m_EncodedSize = 0;
+  m_Hashed = false;
+}
+
+///////////////////////////////////////
+// pixels in the order they are encoded, either m_Pixels,
+// or its rows copied to Buffer in pass order
+///////////////////////////////////////
+const U8String& GifImageData::EncodingOrder( U8String& Buffer ) const
+{
+  if( m_InterlacedWidth == 0 )
+    return m_Pixels;
+
+  Buffer.resize( m_Pixels.size() );
+  GifInterlace::Interlace( m_Pixels.data(), &Buffer[0],
+                           m_InterlacedWidth, m_Pixels.size() / m_InterlacedWidth );
+  return Buffer;
+}
+
+///////////////////////////////////////
+void GifImageData::BitsPerPixel( const uint8_t Bpp )
+{
+  if( Bpp != m_BitsPerPixel )
+  {
+    if( m_Pending )
+      Decode();  // with the bpp it was encoded with
+
+    m_BitsPerPixel = Bpp;
+    Modified();
+  }
+}
+
+///////////////////////////////////////
+size_t GifImageData::Size() const
+{
+  if( m_Pending )
+    Decode();
+
+  return m_Pixels.size();
+}
+
 ///////////////////////////////////////
 void GifImageData::SetAllPixels( const uint8_t ColorIndex )
 {
+  if( m_Pending )
+    Decode();
+
   m_Pixels.assign( m_Pixels.size(), ColorIndex );
+  Modified();
 }
 
 ///////////////////////////////////////////////////////////
 void GifImageData::SetPixel( const uint32_t Index, const uint8_t ColorIndex )
 {
+  if( m_Pending )
+    Decode();
+
 #ifndef VP_EXTENSION
   if( Index >= m_Pixels.size() )
     VP_THROW( "index out of range" )
 #endif
 
-  m_Pixels[Index] = ColorIndex;
+  if( m_Pixels[Index] != ColorIndex )
+  {
+    m_Pixels[Index] = ColorIndex;
+    Modified();
+  }
 }
 
 //////////////////////////////////////////////////////
 uint8_t GifImageData::GetPixel( const uint32_t Index ) const
 {
+  if( m_Pending )
+    Decode();
+
 #ifndef VP_EXTENSION
   if( Index >= m_Pixels.size() )
     VP_THROW( "index out of range" )
@@ -93,6 +224,137 @@ uint8_t GifImageData::GetPixel( const uint32_t Index ) const
   return m_Pixels[Index];
 }
 
+///////////////////////////////////////
+// interlace rows of Width pixels, or not if Width is 0
+///////////////////////////////////////
+void GifImageData::Interlaced( const uint16_t Width )
+{
+  if( Width != m_InterlacedWidth )
+  {
+    if( m_Pending )
+      Decode();  // in the order it was encoded
+
+    m_InterlacedWidth = Width;
+    Modified();
+  }
+}
+
+///////////////////////////////////////////////////////////
+// set Count pixels from Index, only marked changed if any differs
+///////////////////////////////////////////////////////////
+void GifImageData::SetPixels( const uint32_t Index, const uint8_t* pIndices, const size_t Count )
+{
+  if( m_Pending )
+    Decode();
+
+#ifndef VP_EXTENSION
+  if( Index > m_Pixels.size() || Count > m_Pixels.size() - Index )
+    VP_THROW( "index out of range" )
+#endif
+
+  if( Count != 0 && std::memcmp( &m_Pixels[Index], pIndices, Count ) != 0 )
+  {
+    std::memcpy( &m_Pixels[Index], pIndices, Count );
+    Modified();
+  }
+}
+
+///////////////////////////////////////////////////////////
+void GifImageData::GetPixels( const uint32_t Index, uint8_t* pIndices, const size_t Count ) const
+{
+  if( m_Pending )
+    Decode();
+
+#ifndef VP_EXTENSION
+  if( Index > m_Pixels.size() || Count > m_Pixels.size() - Index )
+    VP_THROW( "index out of range" )
+#endif
+
+  if( Count != 0 )
+    std::memcpy( pIndices, &m_Pixels[Index], Count );
+}
+
+///////////////////////////////////////////////////////////
+// all pixels, row by row
+///////////////////////////////////////////////////////////
+const uint8_t* GifImageData::Data() const
+{
+  if( m_Pending )
+    Decode();
+
+  return m_Pixels.data();
+}
+
+///////////////////////////////////////////////////////////
+// Pixels are looked up in Palette two at a time, and mixed into four
+// hashes of their own, so the lookups and multiplications of one
+// pixel pair don't wait for those of the one before. The hash is kept
+// with a hash of Palette, and computed again only if the pixels or
+// Palette have changed since.
+///////////////////////////////////////////////////////////
+uint64_t GifImageData::Hash( const uint32_t* Palette ) const
+{
+  uint64_t PaletteHash = 0;
+  for( size_t i = 0; i < 256; i += 2 )
+    PaletteHash = Mix( PaletteHash, Palette[i] | static_cast<uint64_t>(Palette[i + 1]) << 32 );
+
+  const uint8_t* p = Data();
+  std::lock_guard<std::mutex> Lock( m_Mutex );
+  if( m_Hashed && m_PaletteHash == PaletteHash )
+    return m_Hash;
+
+  const size_t Count = m_Pixels.size();
+  uint64_t Lanes[4] = { 1, 2, 3, 4 };
+  size_t i = 0;
+  for( ; i + 8 <= Count; i += 8 )
+  {
+    for( size_t k = 0; k < 4; ++k )
+      Lanes[k] = Mix( Lanes[k], Palette[p[i + 2*k]] |
+                                static_cast<uint64_t>(Palette[p[i + 2*k + 1]]) << 32 );
+  }
+
+  for( ; i < Count; ++i )
+    Lanes[0] = Mix( Lanes[0], Palette[p[i]] );
+
+  uint64_t Hash = Count;
+  for( size_t k = 0; k < 4; ++k )
+    Hash = Mix( Hash, Lanes[k] );
+
+  m_Hash = Finish( Hash );
+  m_PaletteHash = PaletteHash;
+  m_Hashed = true;
+  return m_Hash;
+}
+
+///////////////////////////////////////////////////////////
+// Crop in place. Each row of the region moves to an index no larger
+// than where it was, so the rows are moved front to back, and the
+// pixels are then trimmed, without another buffer.
+///////////////////////////////////////////////////////////
+void GifImageData::Crop( const uint16_t RowWidth, const uint16_t Left, const uint16_t Top,
+                         const uint16_t Width, const uint16_t Height )
+{
+  if( m_Pending )
+    Decode();
+
+#ifndef VP_EXTENSION
+  if( RowWidth == 0 || Left + Width > RowWidth ||
+      static_cast<size_t>(RowWidth)*(Top + Height) > m_Pixels.size() )
+    VP_THROW( "index out of range" )
+#endif
+
+  for( size_t y = 0; y < Height; ++y )
+    std::memmove( &m_Pixels[y*Width], &m_Pixels[(y + Top)*RowWidth + Left], Width );
+
+  m_Pixels.resize( static_cast<size_t>(Width)*Height );
+
+  // rows of the interlaced image are shorter now
+  if( m_InterlacedWidth != 0 )
+    m_InterlacedWidth = Width;
+
+  Modified();
+}
+
 //////////////////////////////////////
 void GifImageData::Init( size_t Capacity )
 {
@@ -102,6 +364,97 @@ void GifImageData::Init( size_t Capacity )
 
   // reserve space for decoding
   m_Pixels.reserve( Capacity );
+  m_Capacity = Capacity;
+  m_Pending = false;
+  Modified();
+}
+
+//////////////////////////////////////
+// Decode the sub-block chain kept by operator>>, if not yet.
+// Called on first access to pixels, or by GifImpl when importing
+// without deferring. Throw if the pixels are not as many as expected.
+// Threads that get here at the same time decode it once: the first
+// one decodes, while the others wait and find it done.
+//
+// GifFastDecoder copies strings from the pixels it has output, so
+// interlaced pixels are decoded in pass order, and then each row is
+// copied once to where it belongs.
+////////////////////////////////////////////////////////////////////////
+void GifImageData::Decode() const
+{
+  std::lock_guard<std::mutex> Lock( m_Mutex );
+  if( !m_Pending )
+    return;
+
+  GifFastDecoder Decoder{};  // through still causes warnings of -Weffc++,
+                         // with empty initializer the generated default ctor
+                         // is able to initialize all data members.
+
+  m_Pixels.clear();
+  U8String Interlaced;
+  U8String& Pixels = (m_InterlacedWidth == 0)? m_Pixels : Interlaced;
+  Pixels.reserve( m_Capacity );
+
+  GifSubBlockReader ReadCode( m_Encoded.data(), m_Encoded.size() );
+  Decoder( m_BitsPerPixel, ReadCode, Pixels );
+
+  if( m_Capacity != 0 && Pixels.size() != m_Capacity )
+    throw vp::Exception( "wrong image data size" );
+
+  if( m_InterlacedWidth != 0 )
+  {
+    if( Interlaced.size() % m_InterlacedWidth != 0 )
+      throw vp::Exception( "wrong image data size" );
+
+    m_Pixels.resize( Interlaced.size() );
+    GifInterlace::Deinterlace( Interlaced.data(), &m_Pixels[0],
+                               m_InterlacedWidth, Interlaced.size() / m_InterlacedWidth );
+  }
+
+  m_Pending = false;
+}
+
+//////////////////////////////////////
+// Encode pixels into a sub-block chain, if not yet, so that
+// operator<< only has to write it. Called by GifImpl to encode
+// images on multiple threads before writing them in order. With
+// Threads other than 1, a large image is encoded in chunks on
+// multiple threads, see GifEncoder.
+////////////////////////////////////////////////////////////////////////
+void GifImageData::Encode( const unsigned Threads ) const
+{
+  std::lock_guard<std::mutex> Lock( m_Mutex );
+  if( !m_Encoded.empty() )
+    return;
+
+  GifSubBlockWriter WriteCode( m_Encoded );
+  GifEncoder Encoder( GifDictionary::Auto, Threads );
+  U8String Buffer;
+  Encoder( m_BitsPerPixel, EncodingOrder( Buffer ), WriteCode );
+
+  m_EncodedSize = 1 + m_Encoded.size();  // bpp + sub-blocks
+}
+
+//////////////////////////////////////
+// Size of the encoded image data in bytes, including bpp and the
+// sub-block chain. Codes are only counted, and the result is kept
+// until bpp or pixels change, so measuring an unchanged image is free.
+// Size of imported image data is known without counting.
+////////////////////////////////////////////////////////////////////////
+size_t GifImageData::EncodedSize() const
+{
+  std::lock_guard<std::mutex> Lock( m_Mutex );
+  if( m_EncodedSize == 0 )
+  {
+    GifCodeCounter CountCode;
+    GifEncoder Encoder{};
+    U8String Buffer;
+    Encoder( m_BitsPerPixel, EncodingOrder( Buffer ), CountCode );
+
+    m_EncodedSize = 1 + CountCode.Size();  // bpp + sub-blocks
+  }
+
+  return m_EncodedSize;
 }
 
 ///////////////////////////////////////////////////////////
@@ -110,16 +463,27 @@ std::istream& operator>>( std::istream& is, GifImageData& ImageData )
   // read bpp
   ImageData.m_BitsPerPixel = is.get(); 
 
-  // read codes
-  U8String Codes;
-  GifBlockIO::ReadSubBlocks( is, Codes );
+  // only keep the sub-block chain, decoding is deferred until pixels
+  // are accessed, or Decode() is called
+  U8String& Encoded = ImageData.m_Encoded;
+  MemoryBuf* pBuffer = dynamic_cast<MemoryBuf*>( is.rdbuf() );
+  if( pBuffer != nullptr )
+  {
+    // reading from memory, e.g. a mapped file, find the end of the
+    // chain, and copy it in one piece
+    GifSubBlockReader ReadCode( pBuffer->Current(), pBuffer->Remaining() );
+    ReadCode.Skip();
 
-  // decoding
-  GifDecoder Decoder{};  // through still causes warnings of -Weffc++,
-                         // with empty initializer the generated default ctor
-                         // is able to initialize all data members.
-  Decoder( ImageData.m_BitsPerPixel, Codes, ImageData.m_Pixels );
+    Encoded.assign( pBuffer->Current(), ReadCode.Position() );
+    pBuffer->Advance( ReadCode.Position() );
+  }
+  else
+    GifBlockIO::ReadRawSubBlocks( is, Encoded );
 
+  ImageData.m_Pixels.clear();
+  ImageData.m_Pending = true;
+  ImageData.m_Hashed = false;
+  ImageData.m_EncodedSize = 1 + Encoded.size();  // bpp + sub-blocks
   return is;
 }
 
@@ -129,18 +493,22 @@ std::ostream& operator<<( std::ostream& os, const GifImageData& ImageData )
   // write bpp
   IOutil::Write( os, ImageData.m_BitsPerPixel );
 
-  // reserve space for codes
-  U8String Codes;
-  Codes.reserve( ImageData.m_Pixels.size() );
+  // pixels not changed since read or Encode(), write the sub-blocks,
+  // which may not even be decoded yet
+  if( !ImageData.m_Encoded.empty() )
+  {
+    os.write( reinterpret_cast<const char*>(ImageData.m_Encoded.data()),
+              static_cast<std::streamsize>(ImageData.m_Encoded.size()) );
+    return os;
+  }
 
-  // encoding
+  // encoding, codes are written as sub-blocks as they are produced
+  GifSubBlockWriter WriteCode( os );
   GifEncoder Encoder{};  // through still causes warnings of -Weffc++,
                          // with empty initializer the generated default ctor
                          // is able to initialize all data members.
-  Encoder( ImageData.m_BitsPerPixel, ImageData.m_Pixels, Codes );
-
-  // write codes
-  GifBlockIO::WriteSubBlocks( os, Codes );
+  U8String Buffer;
+  Encoder( ImageData.m_BitsPerPixel, ImageData.EncodingOrder( Buffer ), WriteCode );
 
   return os;
 }
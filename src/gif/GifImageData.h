@@ -20,8 +20,10 @@
 #ifndef GifImageData_h
 #define GifImageData_h
 
+#include <atomic>
 #include <cstdint>
 #include <iosfwd>
+#include <mutex>
 
 #include "U8String.h"
 
@@ -41,24 +43,75 @@ public:
 
   // bpp
   uint8_t BitsPerPixel() const { return m_BitsPerPixel; }
-  void    BitsPerPixel( const uint8_t Bpp ) { m_BitsPerPixel = Bpp; }
+  void    BitsPerPixel( const uint8_t Bpp );
 
   // size
-  size_t Size() const { return m_Pixels.size(); }
+  size_t Size() const;
+  size_t EncodedSize() const;
 
   // pixels
   void    SetAllPixels( const uint8_t ColorIndex );
   void    SetPixel( const uint32_t Index, const uint8_t ColorIndex );
   uint8_t GetPixel( const uint32_t Index ) const;
 
+  // Count pixels from Index at a time, Data() is valid
+  // until pixels or bpp change
+  void    SetPixels( const uint32_t Index, const uint8_t* pIndices, const size_t Count );
+  void    GetPixels( const uint32_t Index, uint8_t* pIndices, const size_t Count ) const;
+  const uint8_t* Data() const;
+
+  // hash of the pixels resolved through Palette of 256 colors,
+  // kept until pixels or bpp, or Palette change
+  uint64_t Hash( const uint32_t* Palette ) const;
+
+  // keep Width x Height pixels at (Left, Top) of rows of RowWidth pixels
+  void    Crop( const uint16_t RowWidth, const uint16_t Left, const uint16_t Top,
+                const uint16_t Width, const uint16_t Height );
+
+  // interlacing, row width if rows are encoded interlaced, 0 if not
+  uint16_t Interlaced() const { return m_InterlacedWidth; }
+  void     Interlaced( const uint16_t Width );
+
   // IO
   void Init( size_t Capacity );
+  bool Decoded() const { return !m_Pending; }
+  void Decode() const;
+  void Encode( const unsigned Threads = 1 ) const;
   friend std::istream& operator>>( std::istream&, GifImageData& );
   friend std::ostream& operator<<( std::ostream&, const GifImageData& );
 
 private:
+  void Modified();
+  const U8String& EncodingOrder( U8String& Buffer ) const;
+
   uint8_t  m_BitsPerPixel;
-  U8String m_Pixels;
+  mutable U8String m_Pixels;  // decoded on first access
+
+  // sub-block chain read by operator>>, or produced by Encode(),
+  // written as it is by operator<< until bpp or pixels change. It is
+  // a copy, also of a mapped file, so that it outlives the input.
+  mutable U8String m_Encoded;
+  size_t   m_Capacity;        // number of pixels expected, 0 if unknown
+  mutable std::atomic<bool> m_Pending;  // m_Encoded not decoded yet
+
+  // bytes written by operator<<, 0 if not yet counted,
+  // reset whenever bpp or pixels change
+  mutable size_t m_EncodedSize;
+
+  // hash of the pixels, valid if m_Hashed, and of the palette
+  // it was computed with, reset whenever bpp or pixels change
+  mutable uint64_t m_Hash;
+  mutable uint64_t m_PaletteHash;
+  mutable bool     m_Hashed;
+
+  // pixels are kept in image order, and only reordered
+  // while being decoded or encoded, see GifInterlace
+  uint16_t m_InterlacedWidth;
+
+  // held while const members write the members above, i.e. decode,
+  // encode, or count and hash, so that threads reading the same image
+  // do it once, and in turn
+  mutable std::mutex m_Mutex;
 };
 
 #endif //GifImageData_h
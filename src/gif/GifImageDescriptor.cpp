@@ -90,6 +90,19 @@ bool GifImageDescriptor::Interlaced() const
   return (m_PackedByte & 0x40) != 0;  // 0x40 = 01000000
 }
 
+////////////////////////////////////////
+// rows are written in pass order if interlaced
+////////////////////////////////////////
+void GifImageDescriptor::Interlaced( const bool Interlace )
+{
+  if( Interlace )
+    m_PackedByte |= 0x40;
+  else
+    m_PackedByte &= 0xBF;  // 0xBF = 10111111
+
+  m_ImageData.Interlaced( Interlace? m_Width : 0 );
+}
+
 ///////////////////////////////////
 bool GifImageDescriptor::ColorTableSorted() const
 {
@@ -130,23 +143,9 @@ void GifImageDescriptor::Crop( const uint16_t Left, const uint16_t Top,
   if( Left == m_Left && Top == m_Top && Width == m_Width && Height == m_Height )
     return;
 
-  // new image data
-  GifImageData ImageData( BitsPerPixel(), static_cast<uint32_t>(Width*Height) );
-
-  // copy pixels from old image data
-  auto dx = Left - m_Left;
-  auto dy = Top - m_Top;
-  for( uint16_t x = 0; x < Width; ++x )
-  {
-    for( uint16_t y = 0; y < Height; ++y )
-    {
-      uint8_t Color = m_ImageData.GetPixel( static_cast<uint32_t>((x + dx) + m_Width*(y + dy)) );
-      ImageData.SetPixel( static_cast<uint32_t>(x + Width*y), Color );
-    }
-  }
-
-  // replace old image data
-  m_ImageData = std::move(ImageData);
+  // move rows of the region to the front, within the same image data
+  m_ImageData.Crop( m_Width, static_cast<uint16_t>(Left - m_Left),
+                    static_cast<uint16_t>(Top - m_Top), Width, Height );
 
   // set parameters to new values
   m_Left = Left;
@@ -155,6 +154,15 @@ void GifImageDescriptor::Crop( const uint16_t Left, const uint16_t Top,
   m_Height = Height;
 }
 
+//////////////////////////////////////////////////////////////
+// move the image within the logical screen
+//////////////////////////////////////////////////////////////
+void GifImageDescriptor::Position( const uint16_t Left, const uint16_t Top )
+{
+  m_Left = Left;
+  m_Top = Top;
+}
+
 ////////////////////////////////////////////////
 uint16_t GifImageDescriptor::ColorTableSize() const
 {
@@ -247,6 +255,73 @@ uint8_t GifImageDescriptor::GetPixel( uint16_t X, uint16_t Y ) const
   return m_ImageData.GetPixel( PixelIndex(X, Y) );
 }
 
+//////////////////////////////////////////////////////////////////////
+// set pixels of a rectangle from pIndices, row by row
+//////////////////////////////////////////////////////////////////////
+void GifImageDescriptor::SetRect( const uint16_t X, const uint16_t Y,
+                                  const uint16_t Width, const uint16_t Height,
+                                  const uint8_t* pIndices )
+{
+#ifndef VP_EXTENSION
+  if( X + Width > m_Width )
+    VP_THROW( "x out of range" );
+
+  if( Y + Height > m_Height )
+    VP_THROW( "y out of range" );
+#endif
+
+  // whole rows are contiguous
+  if( X == 0 && Width == m_Width )
+  {
+    m_ImageData.SetPixels( static_cast<uint32_t>(m_Width)*Y, pIndices,
+                           static_cast<size_t>(Width)*Height );
+    return;
+  }
+
+  for( uint16_t Row = 0; Row < Height; ++Row )
+    m_ImageData.SetPixels( X + static_cast<uint32_t>(m_Width)*(Y + Row),
+                           pIndices + static_cast<size_t>(Width)*Row, Width );
+}
+
+//////////////////////////////////////////////////////////////////////
+// get pixels of a rectangle into pIndices, row by row
+//////////////////////////////////////////////////////////////////////
+void GifImageDescriptor::GetRect( const uint16_t X, const uint16_t Y,
+                                  const uint16_t Width, const uint16_t Height,
+                                  uint8_t* pIndices ) const
+{
+#ifndef VP_EXTENSION
+  if( X + Width > m_Width )
+    VP_THROW( "x out of range" );
+
+  if( Y + Height > m_Height )
+    VP_THROW( "y out of range" );
+#endif
+
+  if( X == 0 && Width == m_Width )
+  {
+    m_ImageData.GetPixels( static_cast<uint32_t>(m_Width)*Y, pIndices,
+                           static_cast<size_t>(Width)*Height );
+    return;
+  }
+
+  for( uint16_t Row = 0; Row < Height; ++Row )
+    m_ImageData.GetPixels( X + static_cast<uint32_t>(m_Width)*(Y + Row),
+                           pIndices + static_cast<size_t>(Width)*Row, Width );
+}
+
+///////////////////////////////////////////////////////////////
+const uint8_t* GifImageDescriptor::Data() const
+{
+  return m_ImageData.Data();
+}
+
+//////////////////////////////////////////////////
+uint64_t GifImageDescriptor::Hash( const uint32_t* Palette ) const
+{
+  return m_ImageData.Hash( Palette );
+}
+
 ////////////////////////////////////////
 GifComponent* GifImageDescriptor::Clone() const
 {
@@ -263,9 +338,6 @@ void GifImageDescriptor::Read( std::istream& is )
   IOutil::Read( is, m_Height );
   m_PackedByte = is.get(); 
 
-  if( Interlaced() )
-    throw vp::Exception( "interlaced image not supported" );
-
   // local color table
   if( LocalColorTable() )
   {
@@ -276,11 +348,28 @@ void GifImageDescriptor::Read( std::istream& is )
   else
     m_ColorTable.Size( 0 );  // no local color table
 
-  // image data
+  // image data, decoded later, see Decode()
   m_ImageData.Init( static_cast<size_t>(m_Width*m_Height) );
+  m_ImageData.Interlaced( Interlaced()? m_Width : 0 );
   is >> m_ImageData;
-  if( m_ImageData.Size() != static_cast<size_t>(m_Width*m_Height) )
-    throw vp::Exception( "wrong image data size" );
+}
+
+/////////////////////////////////////////
+// decode image data, if not yet
+// throw if image data does not match the dimension
+/////////////////////////////////////////
+void GifImageDescriptor::Decode() const
+{
+  if( !m_ImageData.Decoded() )
+    m_ImageData.Decode();
+}
+
+/////////////////////////////////////////
+// encode image data ahead of Write(), if changed
+/////////////////////////////////////////
+void GifImageDescriptor::Encode( const unsigned Threads ) const
+{
+  m_ImageData.Encode( Threads );
 }
 
 ///////////////////////////////////////////
@@ -295,3 +384,13 @@ void GifImageDescriptor::Write( std::ostream& os ) const
   os << m_ColorTable;
   os << m_ImageData;
 }
+
+///////////////////////////////////////////
+// same as the size of Write(), but image data is not encoded
+// unless its pixels have changed since last time
+///////////////////////////////////////////
+size_t GifImageDescriptor::Size() const
+{
+  // ID, left, top, width, height, packed byte
+  return 10 + 3*static_cast<size_t>(m_ColorTable.Size()) + m_ImageData.EncodedSize();
+}
@@ -49,6 +49,7 @@ public:
   uint16_t Height() const { return m_Height; }
   void     Crop( const uint16_t Left, const uint16_t Top,
                  const uint16_t Width, const uint16_t Height );
+  void     Position( const uint16_t Left, const uint16_t Top );
 
   // local color table
   bool     LocalColorTable() const;
@@ -66,13 +67,23 @@ public:
   void     SetAllPixels( const uint8_t ColorIndex );
   void     SetPixel( uint16_t X, uint16_t Y, uint8_t  Index );
   uint8_t  GetPixel( uint16_t X, uint16_t Y ) const;
+  void     SetRect( const uint16_t X, const uint16_t Y,
+                    const uint16_t Width, const uint16_t Height, const uint8_t* pIndices );
+  void     GetRect( const uint16_t X, const uint16_t Y,
+                    const uint16_t Width, const uint16_t Height, uint8_t* pIndices ) const;
+  const uint8_t* Data() const;
+  uint64_t Hash( const uint32_t* Palette ) const;
   bool     Interlaced() const;
+  void     Interlaced( const bool Interlace );
   uint32_t PixelIndex( const uint16_t X, const uint16_t Y ) const;
+  void     Decode() const;
+  void     Encode( const unsigned Threads = 1 ) const;
 
   // overrides
   virtual GifComponent* Clone() const override; 
   virtual void Read ( std::istream& ) override;
   virtual void Write( std::ostream& ) const override;
+  virtual size_t Size() const override;
 
 private:
   uint16_t m_Left;
@@ -22,6 +22,72 @@
 #include "GifGraphicsControlExt.h"
 #include "GifImageDescriptor.h"
 #include "Exception.h"
+#include <algorithm>
+#include <cstring>
+
+namespace
+{
+  //////////////////////////////
+  // copy N bytes of the palette entry of each index,
+  // N is constant so that each copy is a single move
+  ////////////////////////////////////////////////////////////////
+  template<size_t N>
+  void LookUp( const uint8_t* pIndex, const size_t Count,
+               const uint8_t (&Palette)[256][4], uint8_t* pColors )
+  {
+    for( size_t i = 0; i < Count; ++i, pColors += N )
+      std::memcpy( pColors, Palette[pIndex[i]], N );
+  }
+
+  //////////////////////////////
+  // whether Count pixels of A and B have the same colors, looked up
+  // in colors of 0xAARRGGBB, 0 for transparent
+  ////////////////////////////////////////////////////////////////
+  bool SameColors( const uint8_t* pA, const uint32_t (&ColorsA)[256],
+                   const uint8_t* pB, const uint32_t (&ColorsB)[256], const size_t Count )
+  {
+    for( size_t i = 0; i < Count; ++i )
+    {
+      if( ColorsA[pA[i]] != ColorsB[pB[i]] )
+        return false;
+    }
+
+    return true;
+  }
+
+  //////////////////////////////
+  // The same, if the colors of A and B are different only at the
+  // indices of Differ, or nowhere if Differs is 0. A block of equal
+  // indices, none of them in Differ, has the same colors, so only the
+  // other blocks, and the last pixels short of a block, are looked up.
+  // Blocks are of a constant size, so that the compiler vectorizes
+  // the search for Differ.
+  ////////////////////////////////////////////////////////////////
+  bool SameIndices( const uint8_t* pA, const uint32_t (&ColorsA)[256],
+                    const uint8_t* pB, const uint32_t (&ColorsB)[256], const size_t Count,
+                    const uint8_t (&Differ)[2], const size_t Differs )
+  {
+    const size_t Block = 64;
+    size_t i = 0;
+    for( ; i + Block <= Count; i += Block )
+    {
+      bool Same = std::memcmp( pA + i, pB + i, Block ) == 0;
+      if( Same && Differs != 0 )
+      {
+        uint8_t Found = 0;
+        for( size_t k = 0; k < Block; ++k )
+          Found |= static_cast<uint8_t>((pA[i + k] == Differ[0]) | (pA[i + k] == Differ[1]));
+
+        Same = (Found == 0);
+      }
+
+      if( !Same && !SameColors( pA + i, ColorsA, pB + i, ColorsB, Block ) )
+        return false;
+    }
+
+    return SameColors( pA + i, ColorsA, pB + i, ColorsB, Count - i );
+  }
+}
 
 ////////////////////////////////
 GifImageImpl::GifImageImpl( const GifImpl& RefGifImpl )
@@ -75,34 +141,44 @@ bool GifImageImpl::operator==( const GifImageImpl& other ) const
       Width() != other.Width() || Height() != other.Height() )
     return false;
 
-  // compare pixel by pixel
-  for( uint16_t y = 0; y < Height(); ++y )
-  {
-    for( uint16_t x = 0; x < Width(); ++x )
-    {
-      auto ThisTransparent = Transparent( x, y );
-      auto OtherTransparent = other.Transparent( x, y );
-      if( ThisTransparent && OtherTransparent)
-      {
-        // the two pixels are transparent
-        continue;
-      }
-      else if( !ThisTransparent && !OtherTransparent )
-      {
-        // the two pixels have same color
-        uint8_t R1, G1, B1, R2, G2, B2;
-        GetPixel( x, y, R1, G1, B1 );
-        other.GetPixel( x, y, R2, G2, B2 );
-        if( R1 == R2 && G1 == G2 && B1 == B2 )
-          continue;
-      }
+  // look up both palettes, mostly the same color table, or tables
+  // that are different only at the transparent colors
+  uint32_t ColorsA[256], ColorsB[256];
+  GetPalette( ColorsA );
+  other.GetPalette( ColorsB );
 
-      // the two pixels are different
-      return false;
-    }
+  uint8_t Differ[2] = { 0, 0 };
+  size_t Differs = 0;
+  for( size_t i = 0; i < 256; ++i )
+  {
+    if( ColorsA[i] != ColorsB[i] && Differs++ < 2 )
+      Differ[Differs - 1] = static_cast<uint8_t>(i);
   }
 
-  return true;
+  const size_t Count = static_cast<size_t>(Width())*Height();
+  if( Differs > 2 )
+    return SameColors( Data(), ColorsA, other.Data(), ColorsB, Count );
+
+  if( Differs == 1 )
+    Differ[1] = Differ[0];
+
+  return SameIndices( Data(), ColorsA, other.Data(), ColorsB, Count, Differ, Differs );
+}
+
+//////////////////////
+// Hash of the colors of the pixels, as GetRGBA() gives them but with
+// all transparent pixels alike, and of the origin and dimension, so
+// images equal by operator== have equal hashes. The hash of the pixels
+// is kept by GifImageData until the pixels or the palette change.
+//////////////////////
+uint64_t GifImageImpl::Hash() const
+{
+  uint32_t Colors[256];
+  GetPalette( Colors );
+
+  uint64_t Geometry = static_cast<uint64_t>(Left()) << 48 | static_cast<uint64_t>(Top()) << 32 |
+                      static_cast<uint64_t>(Width()) << 16 | Height();
+  return ImageDescriptor()->Hash( Colors ) ^ Geometry*0x9E3779B97F4A7C15ull;
 }
 
 //////////////////////
@@ -210,6 +286,12 @@ bool GifImageImpl::Interlaced() const
   return ImageDescriptor()->Interlaced();
 }
 
+/////////////////////////
+void GifImageImpl::Interlaced( const bool Interlace )
+{
+  ImageDescriptor()->Interlaced( Interlace );
+}
+
 /////////////////
 // get size of local or global color table
 ///////////////////////////////////////////
@@ -230,6 +312,88 @@ bool GifImageImpl::CheckColorIndex( const uint8_t ColorIndex ) const
   return ColorIndex < CheckColorTable();
 }
 
+/////////////////////////////////////////////
+// The color table, local or global, in 256 entries of RGBA. Alpha is
+// 0 for the transparent color, 255 otherwise, and indices beyond the
+// color table are black.
+/////////////////////////////////////////////
+void GifImageImpl::GetPalette( uint8_t (&Palette)[256][4] ) const
+{
+  std::memset( Palette, 0, sizeof(Palette) );
+  uint16_t Size = CheckColorTable();
+  for( uint16_t i = 0; i < 256; ++i )
+  {
+    if( i < Size )
+    {
+      if( ColorTable() )
+        GetColorTable( static_cast<uint8_t>(i), Palette[i][0], Palette[i][1], Palette[i][2] );
+      else
+        m_GifImpl.GetColorTable( static_cast<uint8_t>(i), Palette[i][0], Palette[i][1], Palette[i][2] );
+    }
+    Palette[i][3] = 255;
+  }
+
+  if( HasTransColor() )
+    Palette[TransColor()][3] = 0;
+}
+
+/////////////////////////////////////////////
+// The same, as 0xAARRGGBB, and 0 for the transparent color, so that
+// all transparent pixels look alike
+/////////////////////////////////////////////
+void GifImageImpl::GetPalette( uint32_t (&Colors)[256] ) const
+{
+  uint8_t Palette[256][4];
+  GetPalette( Palette );
+  for( size_t i = 0; i < 256; ++i )
+  {
+    if( Palette[i][3] == 0 )
+      Colors[i] = 0;
+    else
+      Colors[i] = static_cast<uint32_t>(Palette[i][0]) << 16 |
+                  static_cast<uint32_t>(Palette[i][1]) << 8 | Palette[i][2] | 0xFF000000u;
+  }
+}
+
+/////////////////////////////////////////////
+// Convert color indices of a rectangle into colors of BytesPerPixel
+// (3 or 4) bytes. The color table, local or global, is looked up once
+// into 256 entries of RGBA, so each pixel takes a single table lookup
+// and copy. Indices beyond the color table are black.
+/////////////////////////////////////////////
+void GifImageImpl::GetColors( const uint16_t X, const uint16_t Y,
+                              const uint16_t Width, const uint16_t Height,
+                              uint8_t* Colors, const size_t BytesPerPixel ) const
+{
+  const GifImageDescriptor* pDescriptor = ImageDescriptor();
+
+#ifndef VP_EXTENSION
+  if( !(pDescriptor->LocalColorTable() || m_GifImpl.ColorTable()) )
+    VP_THROW( "there's neither global nor local color table" )
+
+  if( X + Width > pDescriptor->Width() )
+    VP_THROW( "x out of range" );
+
+  if( Y + Height > pDescriptor->Height() )
+    VP_THROW( "y out of range" );
+#endif
+
+  uint8_t Palette[256][4];
+  GetPalette( Palette );
+
+  const uint8_t* pData = pDescriptor->Data();
+  for( uint16_t Row = 0; Row < Height; ++Row )
+  {
+    const uint8_t* pIndex = pData + static_cast<size_t>(pDescriptor->Width())*(Y + Row) + X;
+    if( BytesPerPixel == 4 )
+      LookUp<4>( pIndex, Width, Palette, Colors );
+    else
+      LookUp<3>( pIndex, Width, Palette, Colors );
+
+    Colors += BytesPerPixel*Width;
+  }
+}
+
 /////////////////////////////////////////
 void GifImageImpl::SetAllPixels( const uint8_t ColorIndex )
 {
@@ -258,6 +422,69 @@ uint8_t GifImageImpl::GetPixel( const uint16_t X, const uint16_t Y ) const
   return ImageDescriptor()->GetPixel( X, Y );
 }
 
+//////////////////////////////////////////////////////////////////////
+void GifImageImpl::SetRow( const uint16_t Y, const uint8_t* Indices )
+{
+  SetRect( 0, Y, Width(), 1, Indices );
+}
+
+////////////////////////////////////////////////////////////////
+void GifImageImpl::GetRow( const uint16_t Y, uint8_t* Indices ) const
+{
+  GetRect( 0, Y, Width(), 1, Indices );
+}
+
+//////////////////////////////////////////////////////////////////////
+// Indices holds Width x Height color indices, row by row
+//////////////////////////////////////////////////////////////////////
+void GifImageImpl::SetRect( const uint16_t X, const uint16_t Y,
+                            const uint16_t Width, const uint16_t Height,
+                            const uint8_t* Indices )
+{
+#ifndef VP_EXTENSION
+  size_t Count = static_cast<size_t>(Width)*Height;
+  if( Count != 0 && !CheckColorIndex( *std::max_element( Indices, Indices + Count ) ) )
+    VP_THROW( "color index out of range" )
+#endif
+
+  ImageDescriptor()->SetRect( X, Y, Width, Height, Indices );
+}
+
+////////////////////////////////////////////////////////////////
+void GifImageImpl::GetRect( const uint16_t X, const uint16_t Y,
+                            const uint16_t Width, const uint16_t Height,
+                            uint8_t* Indices ) const
+{
+  ImageDescriptor()->GetRect( X, Y, Width, Height, Indices );
+}
+
+////////////////////////////////////////////////////////////////
+const uint8_t* GifImageImpl::Data() const
+{
+  return ImageDescriptor()->Data();
+}
+
+////////////////////////////////////////////////////////////////
+// colors of a rectangle, 3 bytes per pixel, row by row
+////////////////////////////////////////////////////////////////
+void GifImageImpl::GetRGB( const uint16_t X, const uint16_t Y,
+                           const uint16_t Width, const uint16_t Height,
+                           uint8_t* RGB ) const
+{
+  GetColors( X, Y, Width, Height, RGB, 3 );
+}
+
+////////////////////////////////////////////////////////////////
+// colors of a rectangle, 4 bytes per pixel, row by row,
+// alpha is 0 for transparent pixels, 255 otherwise
+////////////////////////////////////////////////////////////////
+void GifImageImpl::GetRGBA( const uint16_t X, const uint16_t Y,
+                            const uint16_t Width, const uint16_t Height,
+                            uint8_t* RGBA ) const
+{
+  GetColors( X, Y, Width, Height, RGBA, 4 );
+}
+
 ///////////////////////////////////////////////
 void GifImageImpl::GetPixel( const uint16_t X, const uint16_t Y,
                              uint8_t& Red, uint8_t& Green, uint8_t& Blue ) const
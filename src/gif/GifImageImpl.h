@@ -61,6 +61,7 @@ struct GifImageImpl
 
   // compare
   bool operator==( const GifImageImpl& ) const;
+  uint64_t Hash() const;
 
   // bpp
   uint8_t  BitsPerPixel() const;
@@ -76,9 +77,21 @@ struct GifImageImpl
 
   // pixels
   bool    Interlaced() const;
+  void    Interlaced( const bool Interlace );
   void    SetAllPixels( const uint8_t Index );
   void    SetPixel( const uint16_t X, const uint16_t Y, const uint8_t Index );
   uint8_t GetPixel( const uint16_t X, const uint16_t Y ) const;
+  void    SetRow( const uint16_t Y, const uint8_t* Indices );
+  void    GetRow( const uint16_t Y, uint8_t* Indices ) const;
+  void    SetRect( const uint16_t X, const uint16_t Y,
+                   const uint16_t Width, const uint16_t Height, const uint8_t* Indices );
+  void    GetRect( const uint16_t X, const uint16_t Y,
+                   const uint16_t Width, const uint16_t Height, uint8_t* Indices ) const;
+  const uint8_t* Data() const;
+  void    GetRGB( const uint16_t X, const uint16_t Y,
+                  const uint16_t Width, const uint16_t Height, uint8_t* RGB ) const;
+  void    GetRGBA( const uint16_t X, const uint16_t Y,
+                   const uint16_t Width, const uint16_t Height, uint8_t* RGBA ) const;
   void    GetPixel( const uint16_t X, const uint16_t Y,
                     uint8_t& Red, uint8_t& Green, uint8_t& Blue ) const;
   bool    Transparent( const uint16_t X, const uint16_t Y ) const;
@@ -113,6 +126,11 @@ struct GifImageImpl
   // utils
   uint16_t CheckColorTable() const;
   bool     CheckColorIndex( const uint8_t ColorIndex ) const;
+  void     GetPalette( uint8_t (&Palette)[256][4] ) const;
+  void     GetPalette( uint32_t (&Colors)[256] ) const;
+  void     GetColors( const uint16_t X, const uint16_t Y,
+                      const uint16_t Width, const uint16_t Height,
+                      uint8_t* Colors, const size_t BytesPerPixel ) const;
   bool     SingleImage() const { return m_pGraphicsControlExt == nullptr; }
 
   const GifGraphicsControlExt* GraphicsControlExt() const ;
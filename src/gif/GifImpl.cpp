@@ -23,7 +23,15 @@
 #include "GifComponentVecUtil.h"
 #include "GifImageVecBuilder.h"
 #include "GifImageImpl.h"
+#include "GifImageDescriptor.h"
+#include "GifRendererImpl.h"
+#include "GifFrameDiff.h"
 #include "IOutil.h"
+#include "MappedFile.h"
+#include "MemoryBuf.h"
+#include "ParallelFor.h"
+#include <algorithm>
+#include <cstring>
 #include <fstream>
 #include <sstream>
 
@@ -35,7 +43,9 @@ GifImpl::GifImpl( const uint8_t BitsPerPixel,
  : m_Header( GifVersion::V89a ),
    m_ScreenDescriptor( BitsPerPixel, Width, Height, GlobalColor ),
    m_ComponentVec( GifComponentVecUtil::Create(BitsPerPixel, Width, Height, Images, GlobalColor) ),
-   m_ImageVec( GifImageVecBuilder()( *this, m_ComponentVec ) )
+   m_ImageVec( GifImageVecBuilder()( *this, m_ComponentVec ) ),
+   m_Threads( 1 ),
+   m_ImageThreads( 1 )
 {
 }
 
@@ -43,7 +53,9 @@ GifImpl::GifImpl( const GifImpl& other )
  : m_Header( other.m_Header ),
    m_ScreenDescriptor( other.m_ScreenDescriptor ),
    m_ComponentVec( GifComponentVecUtil::Create(other.m_ComponentVec) ),
-   m_ImageVec( GifImageVecBuilder()( *this, m_ComponentVec ) )
+   m_ImageVec( GifImageVecBuilder()( *this, m_ComponentVec ) ),
+   m_Threads( other.m_Threads ),
+   m_ImageThreads( other.m_ImageThreads )
 {
 }
 
@@ -102,6 +114,265 @@ uint16_t GifImpl::Height() const
   return m_ScreenDescriptor.Height();
 }
 
+//////////////////////////////////////////////
+// crop the screen and all images in one pass; images are
+// independent of each other, so they are cropped on m_Threads threads
+//////////////////////////////////////////////////////////
+void GifImpl::CropAll( const uint16_t Left, const uint16_t Top,
+                       const uint16_t Width, const uint16_t Height )
+{
+#ifndef VP_EXTENSION
+  if( Width == 0 )
+    VP_THROW( "argument 'Width' exceeds lower limit" );
+
+  if( Left + Width > m_ScreenDescriptor.Width() )
+    VP_THROW( "argument 'Width' exceeds upper limit" );
+
+  if( Height == 0 )
+    VP_THROW( "argument 'Height' exceeds lower limit" );
+
+  if( Top + Height > m_ScreenDescriptor.Height() )
+    VP_THROW( "argument 'Height' exceeds upper limit" );
+#endif
+
+  Parallel::For( m_ImageVec.size(), m_Threads, [&]( const size_t i ) {
+    GifImageImpl* pImage = m_ImageVec[i]->GetImpl();
+    GifImageDescriptor* pDescriptor = pImage->ImageDescriptor();
+
+    // part of the image within the region
+    int x0 = std::max<int>( Left, pDescriptor->Left() );
+    int y0 = std::max<int>( Top, pDescriptor->Top() );
+    int x1 = std::min<int>( Left + Width, pDescriptor->Left() + pDescriptor->Width() );
+    int y1 = std::min<int>( Top + Height, pDescriptor->Top() + pDescriptor->Height() );
+
+    if( x0 < x1 && y0 < y1 )
+    {
+      pDescriptor->Crop( static_cast<uint16_t>(x0), static_cast<uint16_t>(y0),
+                         static_cast<uint16_t>(x1 - x0), static_cast<uint16_t>(y1 - y0) );
+      pDescriptor->Position( static_cast<uint16_t>(x0 - Left), static_cast<uint16_t>(y0 - Top) );
+    }
+    else
+    {
+      // nothing to show, keep a single pixel of no effect, neither
+      // drawn nor disposed of, as restoring it to the background would
+      // clear a pixel the image never covered in the region
+      pDescriptor->Crop( pDescriptor->Left(), pDescriptor->Top(), 1, 1 );
+      pDescriptor->Position( 0, 0 );
+      if( !pImage->SingleImage() )
+      {
+        pImage->HasTransColor( true );
+        pImage->TransColor( pDescriptor->GetPixel( 0, 0 ) );
+        pImage->DisposalMethod( 1 );
+      }
+    }
+  } );
+
+  m_ScreenDescriptor.Dimension( Width, Height );
+}
+
+namespace
+{
+  //////////////////////////////////
+  // area of a frame that differs from the previous frame, and
+  // whether its image alone, drawn over the previous frame, can
+  // make the change
+  ////////////////////////////////////////////////////////////
+  struct FrameChange
+  {
+    uint16_t X, Y, Width, Height;
+    bool     Covered;
+  };
+
+  //////////////////////////////////
+  // compare frames pPrev and pCur of Width x Height, rendered as RGBA,
+  // Image is the image drawn for pCur
+  ////////////////////////////////////////////////////////////
+  FrameChange Compare( const uint8_t* pPrev, const uint8_t* pCur,
+                       const uint16_t Width, const uint16_t Height,
+                       const vp::GifImage& Image, std::vector<uint8_t>& Indices )
+  {
+    // bounding box of pixels that differ
+    size_t RowSize = 4*static_cast<size_t>(Width);
+    size_t x0 = Width, x1 = 0, y0 = Height, y1 = 0;
+    for( size_t y = 0; y < Height; ++y )
+    {
+      const uint8_t* pA = pPrev + RowSize*y;
+      const uint8_t* pB = pCur + RowSize*y;
+      if( std::memcmp( pA, pB, RowSize ) == 0 )
+        continue;
+
+      x0 = std::min( x0, GifFrameDiff::First( pA, pB, Width ) );
+      x1 = std::max( x1, GifFrameDiff::Last( pA, pB, Width ) );
+      y0 = std::min( y0, y );
+      y1 = y + 1;
+    }
+
+    // nothing changes, keep a single pixel of the image
+    if( y0 == Height )
+    {
+      x0 = Image.Left();
+      y0 = Image.Top();
+      x1 = x0 + 1;
+      y1 = y0 + 1;
+    }
+
+    FrameChange Change{ static_cast<uint16_t>(x0), static_cast<uint16_t>(y0),
+                        static_cast<uint16_t>(x1 - x0), static_cast<uint16_t>(y1 - y0), false };
+
+    // the image has to cover the area...
+    if( x0 < Image.Left() || y0 < Image.Top() ||
+        x1 > static_cast<size_t>(Image.Left()) + Image.Width() ||
+        y1 > static_cast<size_t>(Image.Top()) + Image.Height() ||
+        x1 > Width || y1 > Height )
+      return Change;
+
+    // ...and have a color for each pixel that changes
+    Change.Covered = true;
+    if( Image.HasTransColor() )
+    {
+      Indices.resize( static_cast<size_t>(Change.Width)*Change.Height );
+      Image.GetRect( static_cast<uint16_t>(x0 - Image.Left()), static_cast<uint16_t>(y0 - Image.Top()),
+                     Change.Width, Change.Height, Indices.data() );
+      for( size_t y = y0; y < y1 && Change.Covered; ++y )
+        Change.Covered = GifFrameDiff::Covers( pPrev + RowSize*y + 4*x0, pCur + RowSize*y + 4*x0,
+                                               &Indices[(y - y0)*Change.Width], Change.Width,
+                                               Image.TransColor() );
+    }
+
+    return Change;
+  }
+}
+
+///////////////////////////////////////////
+// Reduce each image to the area where its frame differs from the
+// previous frame, and make pixels that do not change transparent,
+// where this renders the same frames, the previous image then left
+// in place (disposal method 1). It takes two passes over rendered
+// frames: the first finds the changes, the second makes them, an
+// image after the next frame is rendered, which disposes of it.
+// Return true if any image changes.
+///////////////////////////////////////////
+bool GifImpl::OptimizeFrames()
+{
+  size_t Images = m_ImageVec.size();
+  if( Images < 2 )
+    return false;
+
+  uint16_t Width = m_ScreenDescriptor.Width();
+  uint16_t Height = m_ScreenDescriptor.Height();
+  size_t RowSize = 4*static_cast<size_t>(Width);
+  GifRendererImpl Renderer( *this, false, 0 );
+  std::vector<uint8_t> Prev( RowSize*Height, 0 );
+  std::vector<uint8_t> Indices;
+
+  // changes of frames
+  std::vector<FrameChange> Changes;
+  Changes.reserve( Images );
+  for( size_t i = 0; i < Images; ++i )
+  {
+    const uint8_t* pCur = Renderer.Render( i );
+    Changes.push_back( Compare( Prev.data(), pCur, Width, Height, *m_ImageVec[i], Indices ) );
+    std::memcpy( Prev.data(), pCur, Prev.size() );
+  }
+
+  // an image disposed of by method 2 or 3 can only change if the
+  // next one does, as it is then left in place
+  std::vector<bool> Reduce( Images, false );
+  for( size_t i = Images; i-- > 0; )
+  {
+    uint8_t Method = m_ImageVec[i]->DisposalMethod();
+    Reduce[i] = Changes[i].Covered &&
+                ( i + 1 == Images || Reduce[i + 1] || (Method != 2 && Method != 3) );
+  }
+
+  // make the changes
+  bool Changed = false;
+  bool Pending = false;
+  bool Trans = false;
+  uint8_t TransColor = 0;
+  Renderer.Reset();
+  std::fill( Prev.begin(), Prev.end(), 0 );
+  for( size_t i = 0; i <= Images; ++i )
+  {
+    const uint8_t* pCur = (i < Images)? Renderer.Render( i ) : nullptr;
+
+    // image i - 1, now disposed of
+    if( Pending )
+    {
+      vp::GifImage& Image = *m_ImageVec[i - 1];
+      const FrameChange& Change = Changes[i - 1];
+      Changed = Changed || Trans || Change.Width < Image.Width() || Change.Height < Image.Height();
+
+      Image.Crop( Change.X, Change.Y, Change.Width, Change.Height );
+      Image.SetRect( 0, 0, Change.Width, Change.Height, Indices.data() );
+      if( Trans )
+        Image.TransColor( TransColor );
+
+      // drawn over the previous frame
+      if( i > 1 )
+      {
+        vp::GifImage& Previous = *m_ImageVec[i - 2];
+        if( Previous.DisposalMethod() == 2 || Previous.DisposalMethod() == 3 )
+          Previous.DisposalMethod( 1 );
+      }
+
+      Pending = false;
+    }
+
+    if( i == Images )
+      break;
+
+    // new pixels of image i, transparent where they do not change
+    if( Reduce[i] )
+    {
+      const vp::GifImage& Image = *m_ImageVec[i];
+      const FrameChange& Change = Changes[i];
+      Indices.resize( static_cast<size_t>(Change.Width)*Change.Height );
+      Image.GetRect( static_cast<uint16_t>(Change.X - Image.Left()), static_cast<uint16_t>(Change.Y - Image.Top()),
+                     Change.Width, Change.Height, Indices.data() );
+
+      // transparent color, or one not in use
+      Trans = Image.HasTransColor();
+      TransColor = Trans? Image.TransColor() : 0;
+      if( !Trans )
+      {
+        std::vector<size_t> Hits( 256, 0 );
+        for( uint8_t Index : Indices )
+          ++Hits[Index];
+
+        uint16_t TableSize = Image.CheckColorTable();
+        for( uint16_t c = 0; c < TableSize && !Trans; ++c )
+        {
+          if( Hits[c] == 0 )
+          {
+            Trans = true;
+            TransColor = static_cast<uint8_t>(c);
+          }
+        }
+      }
+
+      if( Trans )
+      {
+        size_t Marked = 0;
+        for( size_t y = 0; y < Change.Height; ++y )
+        {
+          size_t Offset = RowSize*(Change.Y + y) + 4*static_cast<size_t>(Change.X);
+          Marked += GifFrameDiff::Mark( Prev.data() + Offset, pCur + Offset,
+                                        &Indices[y*Change.Width], Change.Width, TransColor );
+        }
+
+        Trans = Marked != 0;
+      }
+
+      Pending = true;
+    }
+
+    std::memcpy( Prev.data(), pCur, Prev.size() );
+  }
+
+  return Changed;
+}
+
 //////////////////////////////////
 bool GifImpl::ColorTable() const
 {
@@ -265,34 +536,71 @@ bool GifImpl::Remove( const size_t Index )
 }
 
 //////////////////////////////////////////////
-bool GifImpl::Import( const std::string& FileName )
+bool GifImpl::Import( const std::string& FileName, const bool Lazy )
 {
-  std::ifstream File;
-
-  // check existence
-  File.open( FileName, std::ios::binary );
-  if( !File.is_open() )
+  // map the file into memory, and parse it in place, image data
+  // is copied out, as it is kept after the file is unmapped
+  MappedFile File( FileName );
+  if( !File )
     return false;
 
-  try
-  {
-    // read from file
-    uint8_t LastByte = Read( File );
+  Import( File.Data(), File.Size(), Lazy );
 
-    File.close();
-    if( LastByte != m_GifTrailer )
-      throw vp::Exception( "not a valid GIF file" );
+  return true;
+}
 
-    // create GifImageVec
-    m_ImageVec = GifImageVecBuilder()( *this, m_ComponentVec );
+//////////////////////////////////////////////
+// import GIF data in memory, throw if it is not valid
+/////////////////////////////////////////////////////////
+void GifImpl::Import( const uint8_t* pData, const size_t Size, const bool Lazy )
+{
+  MemoryBuf Buffer( pData, Size );
+  std::istream is( &Buffer );
 
-    return true;
-  }
-  catch( const vp::Exception& )
-  {
-    File.close();
-    throw;
-  }
+  ImportFrom( is, Lazy );
+}
+
+//////////////////////////////////////////////
+// import GIF data from stream, throw if it is not valid
+// if Lazy, image data is only checked when it is decoded
+/////////////////////////////////////////////////////////
+void GifImpl::ImportFrom( std::istream& is, const bool Lazy )
+{
+  uint8_t LastByte = Read( is );
+  if( LastByte != m_GifTrailer )
+    throw vp::Exception( "not a valid GIF file" );
+
+  // create GifImageVec
+  m_ImageVec = GifImageVecBuilder()( *this, m_ComponentVec );
+
+  // image data is only read, decode it now, unless it is deferred
+  // until pixels of the image are accessed
+  if( !Lazy )
+    Decode();
+}
+
+//////////////////////////////////////////////
+// decode image data of all images, if not yet
+// images are independent of each other, so they are decoded on
+// m_Threads threads
+/////////////////////////////////////////////////////////
+void GifImpl::Decode()
+{
+  Parallel::For( m_ImageVec.size(), m_Threads, [this]( const size_t i ) {
+    m_ImageVec[i]->GetImpl()->ImageDescriptor()->Decode();
+  } );
+}
+
+//////////////////////////////////////////////
+// encode image data of all changed images into memory on m_Threads
+// threads, each image in chunks on m_ImageThreads threads,
+// Write() then writes the images in order
+/////////////////////////////////////////////////////////
+void GifImpl::Encode()
+{
+  Parallel::For( m_ImageVec.size(), m_Threads, [this]( const size_t i ) {
+    m_ImageVec[i]->GetImpl()->ImageDescriptor()->Encode( m_ImageThreads );
+  } );
 }
 
 ///////////////////////////////////////////////////////////////
@@ -316,6 +624,24 @@ bool GifImpl::Export( const std::string& FileName, const bool OverWrite )
   return true;
 }
 
+//////////////////////////////////////////////
+// export to Data, which is replaced
+/////////////////////////////////////////////////////////
+void GifImpl::ExportTo( std::vector<uint8_t>& Data )
+{
+  Data.clear();
+  VectorBuf Buffer( Data );
+  std::ostream os( &Buffer );
+
+  Write( os );
+}
+
+//////////////////////////////////////////////
+void GifImpl::ExportTo( std::ostream& os )
+{
+  Write( os );
+}
+
 // read all elements from stream
 ////////////////////////////////////////////
 uint8_t GifImpl::Read( std::istream& is )
@@ -336,6 +662,10 @@ uint8_t GifImpl::Read( std::istream& is )
 /////////////////////////////////////////////
 void GifImpl::Write( std::ostream& os )
 {
+  // on a single thread, images are encoded while they are written
+  if( m_Threads != 1 || m_ImageThreads != 1 )
+    Encode();
+
   os << m_Header;
   os << m_ScreenDescriptor;
   GifComponentVecUtil::Write( os, m_ComponentVec );
@@ -343,11 +673,19 @@ void GifImpl::Write( std::ostream& os )
 }
 
 // size of the resulting GIF file in byte
+// image data is only encoded if changed since last call
 //////////////////////////////////////////
 size_t GifImpl::Size()
 {
+  // images encoded in chunks are larger than counted in one piece
+  if( m_ImageThreads != 1 )
+    Encode();
+
   std::ostringstream os;
-  Write( os );
+  os << m_Header;
+  os << m_ScreenDescriptor;
 
-  return static_cast<size_t>( os.tellp() );
+  return static_cast<size_t>( os.tellp() )
+         + GifComponentVecUtil::Size( m_ComponentVec )
+         + 1;  // trailer
 }
@@ -23,6 +23,7 @@
 #include <cstdint>
 #include <iosfwd>
 #include <string>
+#include <vector>
 #include "GifHeader.h"
 #include "GifScreenDescriptor.h"
 #include "VecDefs.h"
@@ -58,6 +59,9 @@ struct GifImpl
   // dimension
   uint16_t Width() const;
   uint16_t Height() const;
+  void     CropAll( const uint16_t Left, const uint16_t Top,
+                    const uint16_t Width, const uint16_t Height );
+  bool     OptimizeFrames();
 
   // color table
   bool     ColorTable() const;
@@ -81,9 +85,26 @@ struct GifImpl
   bool Remove( const size_t Index );
 
   // IO
-  bool Import( const std::string& FileName );
+  bool Import( const std::string& FileName, const bool Lazy = false );
   bool Export( const std::string& FileName, const bool OverWrite = false );
 
+  // in-memory IO
+  void Import( const uint8_t* pData, const size_t Size, const bool Lazy = false );
+  void ImportFrom( std::istream& is, const bool Lazy = false );
+  void ExportTo( std::vector<uint8_t>& Data );
+  void ExportTo( std::ostream& os );
+  void Decode();
+  void Encode();
+
+  // threads for decoding and encoding images,
+  // 0 means one per hardware thread
+  unsigned Threads() const { return m_Threads; }
+  void     Threads( const unsigned Count ) { m_Threads = Count; }
+
+  // threads for encoding chunks of each image, see GifEncoder
+  unsigned ImageThreads() const { return m_ImageThreads; }
+  void     ImageThreads( const unsigned Count ) { m_ImageThreads = Count; }
+
   // IO utils
   uint8_t Read( std::istream& );
   void    Write( std::ostream& );
@@ -98,6 +119,8 @@ struct GifImpl
   GifScreenDescriptor m_ScreenDescriptor;
   GifComponentVec     m_ComponentVec;
   GifImageVec         m_ImageVec;
+  unsigned            m_Threads;
+  unsigned            m_ImageThreads;
 
   static const uint8_t m_GifTrailer = 0x3B;
 };
@@ -0,0 +1,81 @@
+////////////////////////////////////////////////////////////////////////
+// Copyright (C) 2019 Xueyi Yao
+//
+// This file is part of VPixels.
+//
+// VPixels is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+// 
+// VPixels is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+// 
+// You should have received a copy of the GNU General Public License
+// along with VPixels.  If not, see <https://www.gnu.org/licenses/>.
+////////////////////////////////////////////////////////////////////////
+
+#ifndef GifInterlace_h
+#define GifInterlace_h
+
+#include <cstdint>
+#include <cstddef>
+#include <cstring>
+
+//////////////////////////////
+// Row order of interlaced image data. Rows are encoded in 4 passes:
+//   pass 1: every 8th row, starting from row 0
+//   pass 2: every 8th row, starting from row 4
+//   pass 3: every 4th row, starting from row 2
+//   pass 4: every 2nd row, starting from row 1
+// Pixels are kept in image order; they are only in pass order while
+// they are decoded or encoded.
+////////////////////////////////////////////////////////////////
+namespace GifInterlace
+{
+  //////////////////////////////////
+  // Call Func(Row) for each row of an image of Height rows,
+  // in the order the rows are encoded
+  ////////////////////////////////////////////////////////////
+  template<typename F>
+  void ForEachRow( const size_t Height, F Func )
+  {
+    static const size_t Start[] = { 0, 4, 2, 1 };
+    static const size_t Step[]  = { 8, 8, 4, 2 };
+
+    for( size_t Pass = 0; Pass < 4; ++Pass )
+    {
+      for( size_t Row = Start[Pass]; Row < Height; Row += Step[Pass] )
+        Func( Row );
+    }
+  }
+
+  //////////////////////////////////
+  // copy each row of pStream, in pass order, to its place in pImage
+  ////////////////////////////////////////////////////////////
+  inline void Deinterlace( const uint8_t* pStream, uint8_t* pImage,
+                           const size_t Width, const size_t Height )
+  {
+    ForEachRow( Height, [&]( const size_t Row ) {
+      std::memcpy( pImage + Row*Width, pStream, Width );
+      pStream += Width;
+    } );
+  }
+
+  //////////////////////////////////
+  // copy the rows of pImage to pStream in pass order
+  ////////////////////////////////////////////////////////////
+  inline void Interlace( const uint8_t* pImage, uint8_t* pStream,
+                         const size_t Width, const size_t Height )
+  {
+    ForEachRow( Height, [&]( const size_t Row ) {
+      std::memcpy( pStream, pImage + Row*Width, Width );
+      pStream += Width;
+    } );
+  }
+
+} // namespace GifInterlace
+
+#endif //GifInterlace_h
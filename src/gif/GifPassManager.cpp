@@ -0,0 +1,122 @@
+////////////////////////////////////////////////////////////////////////
+// Copyright (C) 2019 Xueyi Yao
+//
+// This file is part of VPixels.
+//
+// VPixels is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+// 
+// VPixels is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+// 
+// You should have received a copy of the GNU General Public License
+// along with VPixels.  If not, see <https://www.gnu.org/licenses/>.
+////////////////////////////////////////////////////////////////////////
+
+#include "GifPassManager.h"
+#include "GifPasses.h"
+#include "Gif.h"
+#include "Exception.h"
+
+using namespace vp;
+
+///////////////////////////////////////////////////////////
+GifPassManager GifPassManager::Downsize()
+{
+  GifPassManager Manager;
+  for( Pass Each : { Pass::RemoveDuplicates, Pass::OptimizeFrames, Pass::Remove1PixelImages,
+                     Pass::SingleColorTable, Pass::CommonColorTable, Pass::LocalColorTables,
+                     Pass::ReduceBpp } )
+    Manager.Add( Each );
+
+  return Manager;
+}
+
+///////////////////////////////////////////////////////////
+std::string GifPassManager::Name( const Pass Each )
+{
+  switch( Each )
+  {
+    case Pass::Remove1PixelImages: return "Remove1PixelImages";
+    case Pass::RemoveDuplicates:   return "RemoveDuplicates";
+    case Pass::OptimizeFrames:     return "OptimizeFrames";
+    case Pass::SingleColorTable:   return "SingleColorTable";
+    case Pass::CommonColorTable:   return "CommonColorTable";
+    case Pass::LocalColorTables:   return "LocalColorTables";
+    case Pass::ReduceBpp:          return "ReduceBpp";
+  }
+
+  VP_THROW( "pass not supported" );
+}
+
+///////////////////////////////////////////////////////////
+void GifPassManager::Add( const Pass Each )
+{
+  Function Func;
+  switch( Each )
+  {
+    case Pass::Remove1PixelImages: Func = GifPasses::Remove1PixelImages; break;
+    case Pass::RemoveDuplicates:   Func = GifPasses::RemoveDuplicates;   break;
+    case Pass::OptimizeFrames:     Func = GifPasses::OptimizeFrames;     break;
+    case Pass::SingleColorTable:   Func = GifPasses::SingleColorTable;   break;
+    case Pass::CommonColorTable:   Func = GifPasses::CommonColorTable;   break;
+    case Pass::LocalColorTables:   Func = GifPasses::LocalColorTables;   break;
+    case Pass::ReduceBpp:          Func = GifPasses::ReduceBpp;          break;
+  }
+
+  Add( Name( Each ), Func );
+}
+
+///////////////////////////////////////////////////////////
+void GifPassManager::Add( const std::string& Name, Function Func )
+{
+#ifndef VP_EXTENSION
+  if( !Func )
+    VP_THROW( "no function for pass" );
+#endif
+
+  m_Passes.emplace_back( Name, std::move(Func) );
+}
+
+///////////////////////////////////////////////////////////
+size_t GifPassManager::Passes() const
+{
+  return m_Passes.size();
+}
+
+///////////////////////////////////////////////////////////
+const std::string& GifPassManager::Name( const size_t Index ) const
+{
+#ifndef VP_EXTENSION
+  if( Index >= m_Passes.size() )
+    VP_THROW( "index out of range" );
+#endif
+
+  return m_Passes[Index].first;
+}
+
+///////////////////////////////////////////////////////////
+// the size to export is only taken again after a pass that changes
+// the Gif, which encodes just the images changed
+///////////////////////////////////////////////////////////
+std::vector<GifPassManager::Result> GifPassManager::Run( Gif& Animation, const bool Measure ) const
+{
+  std::vector<Result> Results;
+  Results.reserve( m_Passes.size() );
+
+  size_t Size = Measure? Animation.Size() : 0;
+  for( const auto& Each : m_Passes )
+  {
+    Result Done{ Each.first, Each.second( Animation ), Size, Size };
+    if( Measure && Done.Changed )
+      Size = Done.SizeAfter = Animation.Size();
+
+    Results.push_back( std::move(Done) );
+  }
+
+  return Results;
+}
@@ -0,0 +1,445 @@
+////////////////////////////////////////////////////////////////////////
+// Copyright (C) 2019 Xueyi Yao
+//
+// This file is part of VPixels.
+//
+// VPixels is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+// 
+// VPixels is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+// 
+// You should have received a copy of the GNU General Public License
+// along with VPixels.  If not, see <https://www.gnu.org/licenses/>.
+////////////////////////////////////////////////////////////////////////
+
+#include "GifPasses.h"
+#include "Gif.h"
+#include "GifImage.h"
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <vector>
+
+namespace
+{
+  // colors, RGB as 0xRRGGBB
+  using Colors = std::vector<uint32_t>;
+
+  //////////////////////////////////
+  // what an image shows
+  ////////////////////////////////////////////////////////////
+  struct Usage
+  {
+    Colors Shown;  // sorted
+    bool   Trans;  // transparent pixels
+
+    // entries of a color table for it
+    size_t Entries() const { return Shown.size() + (Trans? 1 : 0); }
+  };
+
+  //////////////////////////////////
+  // entries of a color table as it is stored, a power of 2, at least 2
+  ////////////////////////////////////////////////////////////
+  size_t TableSize( const size_t Entries )
+  {
+    size_t Size = 2;
+    while( Size < Entries )
+      Size *= 2;
+
+    return Size;
+  }
+
+  //////////////////////////////////
+  // color table of a vp::Gif or vp::GifImage
+  ////////////////////////////////////////////////////////////
+  template<typename T>
+  Colors Palette( const T& Source )
+  {
+    Colors Table( Source.ColorTableSize() );
+    for( size_t i = 0; i < Table.size(); ++i )
+    {
+      uint8_t R, G, B;
+      Source.GetColorTable( static_cast<uint8_t>(i), R, G, B );
+      Table[i] = (static_cast<uint32_t>(R) << 16) | (static_cast<uint32_t>(G) << 8) | B;
+    }
+
+    return Table;
+  }
+
+  //////////////////////////////////
+  // fill the color table of a vp::Gif or vp::GifImage with Shown,
+  // then an entry for transparent pixels if Trans, then white
+  ////////////////////////////////////////////////////////////
+  template<typename T>
+  void SetTable( T& Target, const Colors& Shown, const bool Trans )
+  {
+    Target.ColorTableSize( static_cast<uint16_t>(std::max<size_t>( Shown.size() + (Trans? 1 : 0), 1 )) );
+    for( size_t i = 0; i < Target.ColorTableSize(); ++i )
+    {
+      uint32_t Color = (i < Shown.size())? Shown[i] : 0xFFFFFF;
+      Target.SetColorTable( static_cast<uint8_t>(i), static_cast<uint8_t>(Color >> 16),
+                            static_cast<uint8_t>(Color >> 8), static_cast<uint8_t>(Color) );
+    }
+  }
+
+  //////////////////////////////////
+  // colors Image shows of its color table Table, in one pass over
+  // its color indices
+  ////////////////////////////////////////////////////////////
+  Usage Use( const vp::GifImage& Image, const Colors& Table )
+  {
+    std::array<size_t, 256> Hits{};
+    const uint8_t* pData = Image.Data();
+    size_t Count = static_cast<size_t>(Image.Width())*Image.Height();
+    for( size_t i = 0; i < Count; ++i )
+      ++Hits[pData[i]];
+
+    Usage Used{ Colors(), false };
+    if( Image.HasTransColor() && Hits[Image.TransColor()] != 0 )
+    {
+      Used.Trans = true;
+      Hits[Image.TransColor()] = 0;
+    }
+
+    for( size_t i = 0; i < Table.size(); ++i )
+    {
+      if( Hits[i] != 0 )
+        Used.Shown.push_back( Table[i] );
+    }
+
+    std::sort( Used.Shown.begin(), Used.Shown.end() );
+    Used.Shown.erase( std::unique( Used.Shown.begin(), Used.Shown.end() ), Used.Shown.end() );
+    return Used;
+  }
+
+  //////////////////////////////////
+  // Set the color indices of Image, of colors in Old, to those of the
+  // same colors in Shown, the color table it has now, and transparent
+  // pixels to the entry after them. Shown contains the colors Used.
+  ////////////////////////////////////////////////////////////
+  void Remap( vp::GifImage& Image, const Colors& Old, const Usage& Used, const Colors& Shown )
+  {
+    std::array<uint8_t, 256> Map{};
+    for( size_t i = 0; i < Old.size(); ++i )
+    {
+      auto it = std::lower_bound( Shown.begin(), Shown.end(), Old[i] );
+      if( it != Shown.end() && *it == Old[i] )
+        Map[i] = static_cast<uint8_t>(it - Shown.begin());
+    }
+
+    uint8_t Trans = static_cast<uint8_t>(Shown.size());
+    if( Used.Trans )
+      Map[Image.TransColor()] = Trans;
+
+    size_t Count = static_cast<size_t>(Image.Width())*Image.Height();
+    std::vector<uint8_t> Indices( Image.Data(), Image.Data() + Count );
+    for( auto& Index : Indices )
+      Index = Map[Index];
+
+    Image.SetRect( 0, 0, Image.Width(), Image.Height(), Indices.data() );
+    if( Used.Trans )
+      Image.TransColor( Trans );
+    else if( Image.HasTransColor() )
+      Image.HasTransColor( false );
+  }
+
+  //////////////////////////////////
+  // index of the background color, once the global color table
+  // changes from Old to Shown, 0 if not there
+  ////////////////////////////////////////////////////////////
+  uint8_t Background( const vp::Gif& Gif, const Colors& Old, const Colors& Shown )
+  {
+    if( Gif.BackgroundColor() >= Old.size() )
+      return 0;
+
+    auto it = std::lower_bound( Shown.begin(), Shown.end(), Old[Gif.BackgroundColor()] );
+    if( it == Shown.end() || *it != Old[Gif.BackgroundColor()] )
+      return 0;
+
+    return static_cast<uint8_t>(it - Shown.begin());
+  }
+
+  //////////////////////////////////
+  // color tables and usage of all images, before any changes
+  ////////////////////////////////////////////////////////////
+  void UseAll( const vp::Gif& Gif, const Colors& Global,
+               std::vector<Colors>& Tables, std::vector<Usage>& Used )
+  {
+    for( size_t i = 0; i < Gif.Images(); ++i )
+    {
+      const vp::GifImage& Image = Gif[i];
+      Tables.push_back( Image.ColorTable()? Palette( Image ) : Global );
+      Used.push_back( Use( Image, Tables.back() ) );
+    }
+  }
+}
+
+//////////////////////////////////////////////
+// A 1 x 1 transparent image, left in place, after an image also left
+// in place, shows the same frame as the image before it.
+/////////////////////////////////////////////////////////
+bool GifPasses::Remove1PixelImages( vp::Gif& Gif )
+{
+  // a single image keeps no transparent color, so keep 2
+  bool Changed = false;
+  size_t j = 1;
+  while( j < Gif.Images() && Gif.Images() > 2 )
+  {
+    vp::GifImage& Prev = Gif[j - 1];
+    vp::GifImage& Image = Gif[j];
+    if( Image.Width() == 1 && Image.Height() == 1 && Image.Transparent( 0, 0 ) &&
+        Prev.DisposalMethod() != 2 && Prev.DisposalMethod() != 3 &&
+        Image.DisposalMethod() != 2 && Image.DisposalMethod() != 3 &&
+        Prev.Delay() + Image.Delay() <= UINT16_MAX )
+    {
+      Prev.Delay( static_cast<uint16_t>(Prev.Delay() + Image.Delay()) );
+      Gif.Remove( j );
+      Changed = true;
+    }
+    else
+      ++j;
+  }
+
+  return Changed;
+}
+
+//////////////////////////////////////////////
+// An image equal to the one before shows the same frame, unless the
+// one before is restored to background. The one left takes the
+// disposal method of the one removed, which restores to the frame
+// before it only if the one left does. Two images merge into a single
+// image, which has no disposal method, unless they have a transparent
+// color, which a single image does not keep.
+/////////////////////////////////////////////////////////
+bool GifPasses::RemoveDuplicates( vp::Gif& Gif )
+{
+  bool Changed = false;
+  size_t j = 1;
+  while( j < Gif.Images() )
+  {
+    vp::GifImage& Prev = Gif[j - 1];
+    vp::GifImage& Image = Gif[j];
+    const bool Last = Gif.Images() == 2;
+    uint8_t Method = Image.DisposalMethod();
+    if( Prev.DisposalMethod() != 2 && Prev.Delay() + Image.Delay() <= UINT16_MAX &&
+        !(Last && Prev.HasTransColor()) && Prev == Image )
+    {
+      if( Last )
+        Method = 0;
+      else if( Method == 3 && Prev.DisposalMethod() != 3 )
+        Method = 1;
+
+      Prev.Delay( static_cast<uint16_t>(Prev.Delay() + Image.Delay()) );
+      Prev.DisposalMethod( Method );
+      Gif.Remove( j );
+      Changed = true;
+    }
+    else
+      ++j;
+  }
+
+  return Changed;
+}
+
+//////////////////////////////////////////////
+bool GifPasses::OptimizeFrames( vp::Gif& Gif )
+{
+  return Gif.OptimizeFrames();
+}
+
+//////////////////////////////////////////////
+// All colors shown, and an entry for transparent pixels if any, in
+// the global color table, if it takes no more than 256 entries, and
+// it is smaller, or there are local color tables to remove.
+/////////////////////////////////////////////////////////
+bool GifPasses::SingleColorTable( vp::Gif& Gif )
+{
+  Colors Global = Palette( Gif );
+  std::vector<Colors> Tables;
+  std::vector<Usage> Used;
+  UseAll( Gif, Global, Tables, Used );
+
+  Usage All{ Colors(), false };
+  bool Local = false;
+  for( size_t i = 0; i < Gif.Images(); ++i )
+  {
+    All.Shown.insert( All.Shown.end(), Used[i].Shown.begin(), Used[i].Shown.end() );
+    All.Trans = All.Trans || Used[i].Trans;
+    Local = Local || Gif[i].ColorTable();
+  }
+
+  std::sort( All.Shown.begin(), All.Shown.end() );
+  All.Shown.erase( std::unique( All.Shown.begin(), All.Shown.end() ), All.Shown.end() );
+  if( All.Entries() > 256 )
+    return false;
+
+  if( !Local && TableSize( All.Entries() ) >= Gif.ColorTableSize() )
+    return false;
+
+  uint8_t BackgroundColor = Background( Gif, Global, All.Shown );
+  SetTable( Gif, All.Shown, All.Trans );
+  Gif.BackgroundColor( BackgroundColor );
+  for( size_t i = 0; i < Gif.Images(); ++i )
+  {
+    vp::GifImage& Image = Gif[i];
+    Image.ColorTableSize( 0 );
+    Remap( Image, Tables[i], Used[i], All.Shown );
+  }
+
+  return true;
+}
+
+//////////////////////////////////////////////
+// The colors shown by an image of a local color table, that most
+// images show no other colors than, in the global color table, if
+// color tables take less space. Images that show other colors have
+// local color tables of their colors.
+/////////////////////////////////////////////////////////
+bool GifPasses::CommonColorTable( vp::Gif& Gif )
+{
+  Colors Global = Palette( Gif );
+  std::vector<Colors> Tables;
+  std::vector<Usage> Used;
+  UseAll( Gif, Global, Tables, Used );
+
+  // colors most images can share
+  size_t Images = Gif.Images();
+  size_t Common = Images;
+  size_t Sharing = 0;
+  for( size_t k = 0; k < Images; ++k )
+  {
+    if( !Gif[k].ColorTable() )
+      continue;
+
+    size_t Count = 0;
+    for( size_t i = 0; i < Images; ++i )
+      Count += std::includes( Used[k].Shown.begin(), Used[k].Shown.end(),
+                              Used[i].Shown.begin(), Used[i].Shown.end() );
+
+    if( Count > Sharing )
+    {
+      Common = k;
+      Sharing = Count;
+    }
+  }
+
+  if( Sharing < 2 )
+    return false;
+
+  // entries of color tables before and after
+  const Colors& Shown = Used[Common].Shown;
+  std::vector<bool> Shares( Images, false );
+  bool Trans = false;
+  size_t Before = Gif.ColorTableSize();
+  size_t After = 0;
+  for( size_t i = 0; i < Images; ++i )
+  {
+    Before += Gif[i].ColorTableSize();
+    Shares[i] = std::includes( Shown.begin(), Shown.end(),
+                               Used[i].Shown.begin(), Used[i].Shown.end() );
+    if( Shares[i] )
+      Trans = Trans || Used[i].Trans;
+    else if( Used[i].Entries() > 256 )
+      return false;
+    else
+      After += TableSize( Used[i].Entries() );
+  }
+
+  if( Shown.size() + (Trans? 1 : 0) > 256 )
+    return false;
+
+  After += TableSize( Shown.size() + (Trans? 1 : 0) );
+  if( After >= Before )
+    return false;
+
+  uint8_t BackgroundColor = Background( Gif, Global, Shown );
+  SetTable( Gif, Shown, Trans );
+  Gif.BackgroundColor( BackgroundColor );
+  for( size_t i = 0; i < Images; ++i )
+  {
+    vp::GifImage& Image = Gif[i];
+    if( Shares[i] )
+    {
+      Image.ColorTableSize( 0 );
+      Remap( Image, Tables[i], Used[i], Shown );
+    }
+    else
+    {
+      SetTable( Image, Used[i].Shown, Used[i].Trans );
+      Remap( Image, Tables[i], Used[i], Used[i].Shown );
+    }
+  }
+
+  return true;
+}
+
+//////////////////////////////////////////////
+// Local color tables reduced to the colors shown, and an entry for
+// transparent pixels if any, if smaller. The global color table is
+// removed if no image uses it.
+/////////////////////////////////////////////////////////
+bool GifPasses::LocalColorTables( vp::Gif& Gif )
+{
+  bool Changed = false;
+  bool Global = false;
+  for( size_t i = 0; i < Gif.Images(); ++i )
+  {
+    vp::GifImage& Image = Gif[i];
+    if( !Image.ColorTable() )
+    {
+      Global = true;
+      continue;
+    }
+
+    Colors Table = Palette( Image );
+    Usage Used = Use( Image, Table );
+    if( Used.Entries() > 256 || TableSize( Used.Entries() ) >= Image.ColorTableSize() )
+      continue;
+
+    SetTable( Image, Used.Shown, Used.Trans );
+    Remap( Image, Table, Used, Used.Shown );
+    Changed = true;
+  }
+
+  if( Gif.ColorTable() && !Global )
+  {
+    Gif.ColorTableSize( 0 );
+    Changed = true;
+  }
+
+  return Changed;
+}
+
+//////////////////////////////////////////////
+// Bits per pixel of each image, just enough for its largest color
+// index, the transparent color included
+/////////////////////////////////////////////////////////
+bool GifPasses::ReduceBpp( vp::Gif& Gif )
+{
+  bool Changed = false;
+  for( size_t i = 0; i < Gif.Images(); ++i )
+  {
+    vp::GifImage& Image = Gif[i];
+    size_t Count = static_cast<size_t>(Image.Width())*Image.Height();
+    uint8_t Max = *std::max_element( Image.Data(), Image.Data() + Count );
+    if( Image.HasTransColor() )
+      Max = std::max( Max, Image.TransColor() );
+
+    uint8_t Bpp = 2;
+    while( (1u << Bpp) <= Max )
+      ++Bpp;
+
+    if( Bpp < Image.BitsPerPixel() )
+    {
+      Image.BitsPerPixel( Bpp );
+      Changed = true;
+    }
+  }
+
+  return Changed;
+}
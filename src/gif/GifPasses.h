@@ -0,0 +1,42 @@
+////////////////////////////////////////////////////////////////////////
+// Copyright (C) 2019 Xueyi Yao
+//
+// This file is part of VPixels.
+//
+// VPixels is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+// 
+// VPixels is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+// 
+// You should have received a copy of the GNU General Public License
+// along with VPixels.  If not, see <https://www.gnu.org/licenses/>.
+////////////////////////////////////////////////////////////////////////
+
+#ifndef GifPasses_h
+#define GifPasses_h
+
+// forward
+namespace vp { class Gif; }
+
+//////////////////////////////
+// Built-in passes of vp::GifPassManager, see there. Each returns true
+// if it changes the Gif.
+////////////////////////////////////////////////////////////////
+namespace GifPasses
+{
+  bool Remove1PixelImages( vp::Gif& );
+  bool RemoveDuplicates( vp::Gif& );
+  bool OptimizeFrames( vp::Gif& );
+  bool SingleColorTable( vp::Gif& );
+  bool CommonColorTable( vp::Gif& );
+  bool LocalColorTables( vp::Gif& );
+  bool ReduceBpp( vp::Gif& );
+
+} // namespace GifPasses
+
+#endif //GifPasses_h
@@ -0,0 +1,58 @@
+////////////////////////////////////////////////////////////////////////
+// Copyright (C) 2019 Xueyi Yao
+//
+// This file is part of VPixels.
+//
+// VPixels is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+// 
+// VPixels is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+// 
+// You should have received a copy of the GNU General Public License
+// along with VPixels.  If not, see <https://www.gnu.org/licenses/>.
+////////////////////////////////////////////////////////////////////////
+
+#include "GifRenderer.h"
+#include "GifRendererImpl.h"
+#include "Gif.h"
+
+using namespace vp;
+
+///////////////////////////////////////////////////////////
+GifRenderer::GifRenderer( const Gif& Animation, const bool Background,
+                          const size_t KeyframeInterval )
+ : m_pImpl( std::make_unique<GifRendererImpl>(*Animation.GetImpl(), Background, KeyframeInterval) )
+{
+}
+
+///////////////////////////////////////////////////////////
+GifRenderer::~GifRenderer() = default;
+
+//////////////////////////////////////////////
+uint16_t GifRenderer::Width() const
+{
+  return m_pImpl->m_Width;
+}
+
+//////////////////////////////////////////////
+uint16_t GifRenderer::Height() const
+{
+  return m_pImpl->m_Height;
+}
+
+//////////////////////////////////////////////
+const uint8_t* GifRenderer::Render( const size_t Index )
+{
+  return m_pImpl->Render( Index );
+}
+
+//////////////////////////////////////////////
+void GifRenderer::Reset()
+{
+  m_pImpl->Reset();
+}
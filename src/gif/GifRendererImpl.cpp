@@ -0,0 +1,222 @@
+////////////////////////////////////////////////////////////////////////
+// Copyright (C) 2019 Xueyi Yao
+//
+// This file is part of VPixels.
+//
+// VPixels is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+// 
+// VPixels is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+// 
+// You should have received a copy of the GNU General Public License
+// along with VPixels.  If not, see <https://www.gnu.org/licenses/>.
+////////////////////////////////////////////////////////////////////////
+
+#include "GifRendererImpl.h"
+#include "GifImpl.h"
+#include "GifImage.h"
+#include "Exception.h"
+#include <algorithm>
+#include <cstring>
+
+////////////////////////////////////////////////////////////
+GifRendererImpl::GifRendererImpl( const GifImpl& Animation, const bool Background,
+                                  const size_t KeyframeInterval )
+ : m_Gif( Animation ),
+   m_Background( Background ),
+   m_Interval( KeyframeInterval ),
+   m_Width( 0 ),
+   m_Height( 0 ),
+   m_BackgroundColor(),
+   m_State(),
+   m_Keyframes(),
+   m_Pixels()
+{
+  Reset();
+}
+
+//////////////////////////////////////////////
+// Start over with an empty canvas, and no keyframes.
+// Dimension and background are those of the Gif now.
+/////////////////////////////////////////////////////////
+void GifRendererImpl::Reset()
+{
+  m_Width = m_Gif.Width();
+  m_Height = m_Gif.Height();
+
+  std::fill( std::begin(m_BackgroundColor), std::end(m_BackgroundColor), 0 );
+  if( m_Background && m_Gif.ColorTable() &&
+      m_Gif.BackgroundColor() < m_Gif.ColorTableSize() )
+  {
+    m_Gif.GetColorTable( m_Gif.BackgroundColor(), m_BackgroundColor[0],
+                         m_BackgroundColor[1], m_BackgroundColor[2] );
+    m_BackgroundColor[3] = 255;
+  }
+
+  m_State.Next = 0;
+  m_State.Canvas.resize( 4*static_cast<size_t>(m_Width)*m_Height );
+  m_State.Saved.clear();
+  Clear( Area{ 0, 0, m_Width, m_Height } );
+
+  m_Keyframes.clear();
+  if( m_Interval != 0 )
+    m_Keyframes.resize( m_Gif.Images()/m_Interval + 1 );
+}
+
+//////////////////////////////////////////////
+// Render frame Index, stepping on from the frame on the canvas if it
+// is not later than Index, nor earlier than the latest keyframe before
+// Index; otherwise from that keyframe, or from the first frame.
+/////////////////////////////////////////////////////////
+const uint8_t* GifRendererImpl::Render( const size_t Index )
+{
+#ifndef VP_EXTENSION
+  if( Index >= m_Gif.Images() )
+    VP_THROW( "index out of range" );
+#endif
+
+  size_t Target = Index + 1;  // frames to be rendered
+  size_t Key = (m_Interval != 0)? Target/m_Interval : 0;
+  while( Key > 0 && m_Keyframes[Key].Canvas.empty() )
+    --Key;
+
+  if( m_State.Next > Target || m_State.Next < Key*m_Interval )
+  {
+    if( Key > 0 )
+      m_State = m_Keyframes[Key];
+    else
+    {
+      m_State.Next = 0;
+      m_State.Saved.clear();
+      Clear( Area{ 0, 0, m_Width, m_Height } );
+    }
+  }
+
+  while( m_State.Next < Target )
+  {
+    Step();
+
+    if( m_Interval != 0 && m_State.Next % m_Interval == 0 &&
+        m_Keyframes[m_State.Next/m_Interval].Canvas.empty() )
+      m_Keyframes[m_State.Next/m_Interval] = m_State;
+  }
+
+  return m_State.Canvas.data();
+}
+
+//////////////////////////////////////////////
+// area of image Index, clipped to the canvas
+/////////////////////////////////////////////////////////
+GifRendererImpl::Area GifRendererImpl::ImageArea( const size_t Index ) const
+{
+  const vp::GifImage& Image = m_Gif[Index];
+  Area Part{ Image.Left(), Image.Top(), 0, 0 };
+  if( Part.X < m_Width )
+    Part.Width = static_cast<uint16_t>(std::min( Image.Width(), static_cast<uint16_t>(m_Width - Part.X) ));
+
+  if( Part.Y < m_Height )
+    Part.Height = static_cast<uint16_t>(std::min( Image.Height(), static_cast<uint16_t>(m_Height - Part.Y) ));
+
+  return Part;
+}
+
+//////////////////////////////////////////////
+// dispose of the frame on the canvas, and draw the next one
+/////////////////////////////////////////////////////////
+void GifRendererImpl::Step()
+{
+  size_t Index = m_State.Next;
+  if( Index > 0 )
+    Dispose( Index - 1 );
+
+  const vp::GifImage& Image = m_Gif[Index];
+  Area Part = ImageArea( Index );
+
+  // keep what is under the image, to be restored
+  if( Image.DisposalMethod() == 3 )
+    Copy( Part, m_State.Canvas.data(), m_State.Saved );
+
+  if( Part.Width != 0 && Part.Height != 0 )
+  {
+    m_Pixels.resize( 4*static_cast<size_t>(Part.Width)*Part.Height );
+    Image.GetRGBA( static_cast<uint16_t>(Part.X - Image.Left()),
+                   static_cast<uint16_t>(Part.Y - Image.Top()),
+                   Part.Width, Part.Height, m_Pixels.data() );
+
+    // draw pixels that are not transparent
+    const uint8_t* pFrom = m_Pixels.data();
+    for( uint16_t Row = 0; Row < Part.Height; ++Row )
+    {
+      uint8_t* pTo = &m_State.Canvas[4*(static_cast<size_t>(Part.Y + Row)*m_Width + Part.X)];
+      for( uint16_t Col = 0; Col < Part.Width; ++Col, pFrom += 4, pTo += 4 )
+      {
+        if( pFrom[3] != 0 )
+          std::memcpy( pTo, pFrom, 4 );
+      }
+    }
+  }
+
+  ++m_State.Next;
+}
+
+//////////////////////////////////////////////
+// dispose of image Index by its disposal method,
+// methods not defined are taken as 0
+/////////////////////////////////////////////////////////
+void GifRendererImpl::Dispose( const size_t Index )
+{
+  switch( m_Gif[Index].DisposalMethod() )
+  {
+    case 2:
+      Clear( ImageArea( Index ) );
+      break;
+
+    case 3:
+      Paste( ImageArea( Index ), m_State.Saved.data() );
+      break;
+
+    default:
+      break;
+  }
+}
+
+//////////////////////////////////////////////
+// fill an area of the canvas with the background
+/////////////////////////////////////////////////////////
+void GifRendererImpl::Clear( const Area& Part )
+{
+  for( uint16_t Row = 0; Row < Part.Height; ++Row )
+  {
+    uint8_t* pTo = &m_State.Canvas[4*(static_cast<size_t>(Part.Y + Row)*m_Width + Part.X)];
+    for( uint16_t Col = 0; Col < Part.Width; ++Col, pTo += 4 )
+      std::memcpy( pTo, m_BackgroundColor, 4 );
+  }
+}
+
+//////////////////////////////////////////////
+// copy an area of a canvas pFrom into To, row by row
+/////////////////////////////////////////////////////////
+void GifRendererImpl::Copy( const Area& Part, const uint8_t* pFrom, std::vector<uint8_t>& To ) const
+{
+  size_t RowSize = 4*static_cast<size_t>(Part.Width);
+  To.resize( RowSize*Part.Height );
+  for( uint16_t Row = 0; Row < Part.Height; ++Row )
+    std::memcpy( &To[RowSize*Row],
+                 pFrom + 4*(static_cast<size_t>(Part.Y + Row)*m_Width + Part.X), RowSize );
+}
+
+//////////////////////////////////////////////
+// copy pFrom, an area row by row, back into the canvas
+/////////////////////////////////////////////////////////
+void GifRendererImpl::Paste( const Area& Part, const uint8_t* pFrom )
+{
+  size_t RowSize = 4*static_cast<size_t>(Part.Width);
+  for( uint16_t Row = 0; Row < Part.Height; ++Row )
+    std::memcpy( &m_State.Canvas[4*(static_cast<size_t>(Part.Y + Row)*m_Width + Part.X)],
+                 pFrom + RowSize*Row, RowSize );
+}
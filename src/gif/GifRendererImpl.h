@@ -0,0 +1,82 @@
+////////////////////////////////////////////////////////////////////////
+// Copyright (C) 2019 Xueyi Yao
+//
+// This file is part of VPixels.
+//
+// VPixels is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+// 
+// VPixels is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+// 
+// You should have received a copy of the GNU General Public License
+// along with VPixels.  If not, see <https://www.gnu.org/licenses/>.
+////////////////////////////////////////////////////////////////////////
+
+#ifndef GifRendererImpl_h
+#define GifRendererImpl_h
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+// forward
+struct GifImpl;
+
+
+//////////////////////////////////////////
+// see vp::GifRenderer
+//////////////////////////////////////////
+struct GifRendererImpl
+{
+  GifRendererImpl( const GifImpl& Animation, const bool Background,
+                   const size_t KeyframeInterval );
+  ~GifRendererImpl() = default;
+
+  // not implemented
+  GifRendererImpl( const GifRendererImpl& ) = delete;
+  GifRendererImpl( GifRendererImpl&& ) = delete;
+  GifRendererImpl& operator=( const GifRendererImpl& ) = delete;
+  GifRendererImpl& operator=( GifRendererImpl&& ) = delete;
+
+  const uint8_t* Render( const size_t Index );
+  void Reset();
+
+  // area of an image within the canvas
+  struct Area
+  {
+    uint16_t X, Y, Width, Height;
+  };
+
+  // what is needed to go on from a rendered frame
+  struct State
+  {
+    size_t Next;                  // frames rendered
+    std::vector<uint8_t> Canvas;
+    std::vector<uint8_t> Saved;   // area under last frame, to restore
+  };
+
+  Area ImageArea( const size_t Index ) const;
+  void Step();
+  void Dispose( const size_t Index );
+  void Clear( const Area& );
+  void Copy( const Area&, const uint8_t* pFrom, std::vector<uint8_t>& To ) const;
+  void Paste( const Area&, const uint8_t* pFrom );
+
+  // data members
+  const GifImpl& m_Gif;
+  bool           m_Background;
+  size_t         m_Interval;
+  uint16_t       m_Width;
+  uint16_t       m_Height;
+  uint8_t        m_BackgroundColor[4];  // RGBA
+  State          m_State;
+  std::vector<State>   m_Keyframes;  // state after every m_Interval frames
+  std::vector<uint8_t> m_Pixels;     // RGBA of an image
+};
+
+#endif //GifRendererImpl_h
@@ -82,6 +82,13 @@ uint8_t GifScreenDescriptor::ColorResolution() const
   return Bpp;
 }
 
+////////////////////////////////////////////////
+void GifScreenDescriptor::Dimension( const uint16_t Width, const uint16_t Height )
+{
+  m_ScreenWidth = Width;
+  m_ScreenHeight = Height;
+}
+
 ////////////////////////////////////////////////
 void GifScreenDescriptor::ColorResolution( const uint8_t Bpp )
 {
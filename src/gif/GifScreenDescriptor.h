@@ -46,6 +46,7 @@ public:
 
   uint16_t Width() const  { return m_ScreenWidth; }
   uint16_t Height() const { return m_ScreenHeight; }
+  void     Dimension( const uint16_t Width, const uint16_t Height );
 
   bool     GlobalColorTable() const;
   uint16_t ColorTableSize() const;
@@ -22,14 +22,22 @@
 
 /////////////////
 GifStringTable::GifStringTable()
+ : m_CurrentGeneration( 1 )
 {
-  Reset();
+  std::fill_n( m_Generation, 4096, 0x0000 );
 }
 
 //////////////////
+// start a new generation, which invalidates all entries
+//////////////////////////////////////////////////////////
 void GifStringTable::Reset()
 {
-  std::fill_n( m_Code, 4096, 0x0000 );
+  // clear the table only when the counter wraps around
+  if( ++m_CurrentGeneration == 0 )
+  {
+    std::fill_n( m_Generation, 4096, 0x0000 );
+    m_CurrentGeneration = 1;
+  }
 }
 
 //////////////////////
@@ -37,12 +45,11 @@ void GifStringTable::Reset()
 /////////////////////////////////////////////
 uint16_t GifStringTable::Search( const uint16_t String, const uint8_t Pixel )
 {
-  uint16_t Code;
   uint16_t Index = Hash( String, Pixel );
-  while( (Code = m_Code[Index]) != 0x0000 )
+  while( InUse( Index ) )
   {
     if( m_Prefix[Index] == String && m_Suffix[Index] == Pixel )
-      return Code;
+      return m_Code[Index];
     else
       Index = Probe( Index );
   }
@@ -58,12 +65,13 @@ void GifStringTable::Add( const uint16_t String, const uint8_t Pixel,
                           const uint16_t Code )
 {
   uint16_t Index = Hash( String, Pixel );
-  while( m_Code[Index] != 0x0000 )
+  while( InUse( Index ) )
     Index = Probe( Index );
 
   m_Prefix[Index] = String;
   m_Suffix[Index] = Pixel;
   m_Code[Index] = Code;
+  m_Generation[Index] = m_CurrentGeneration;
 }
 
 //////////////////////
@@ -76,11 +84,10 @@ uint16_t GifStringTable::Search( const uint16_t String, const uint8_t Pixel,
                                  uint16_t& Index )
 {
   Index = Hash( String, Pixel );
-  uint16_t Code;
-  while( (Code = m_Code[Index]) != 0x0000 )
+  while( InUse( Index ) )
   {
     if( m_Prefix[Index] == String && m_Suffix[Index] == Pixel )
-      return Code;
+      return m_Code[Index];
     else
       Index = Probe( Index );
   }
@@ -101,4 +108,5 @@ void GifStringTable::Add( const uint16_t Index, const uint16_t String,
   m_Prefix[Index] = String;
   m_Suffix[Index] = Pixel;
   m_Code[Index] = Code;
+  m_Generation[Index] = m_CurrentGeneration;
 }
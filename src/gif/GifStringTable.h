@@ -25,10 +25,16 @@
 // A hash table used by Encoder to search for string + pixel pair.
 // Tried std::unordered_map, performance was worse than that of
 // using a brute force search. Reason?
+//
+// An entry is in use only if its generation is the current one,
+// so Reset() just starts a new generation instead of clearing
+// the table.
 /////////////////////////////////////////////////////////////////
 class GifStringTable
 {
 public:
+  typedef uint16_t IndexType;
+
   GifStringTable();
   ~GifStringTable() = default;
 
@@ -51,11 +57,14 @@ public:
 private:
   uint16_t Hash( const uint16_t String, const uint8_t Pixel );
   uint16_t Probe( const uint16_t Index );
+  bool     InUse( const uint16_t Index );
 
   // member data
-  uint16_t m_Prefix[4096];  // string
-  uint8_t  m_Suffix[4096];  // pixel
-  uint16_t m_Code[4096];    // code of string + pixel
+  uint16_t m_Prefix[4096];      // string
+  uint8_t  m_Suffix[4096];      // pixel
+  uint16_t m_Code[4096];        // code of string + pixel
+  uint16_t m_Generation[4096];  // generation when entry was added
+  uint16_t m_CurrentGeneration;
 };
 
 ////////////////////////////////////////
@@ -72,4 +81,10 @@ inline uint16_t GifStringTable::Probe( const uint16_t Index )
   return (Index + 601) & 0x0FFF;
 }
 
+///////////////////////////////////////
+inline bool GifStringTable::InUse( const uint16_t Index )
+{
+  return m_Generation[Index] == m_CurrentGeneration;
+}
+
 #endif //GifStringTable_h
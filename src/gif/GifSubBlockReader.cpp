@@ -0,0 +1,141 @@
+////////////////////////////////////////////////////////////////////////
+// Copyright (C) 2019 Xueyi Yao
+//
+// This file is part of VPixels.
+//
+// VPixels is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+// 
+// VPixels is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+// 
+// You should have received a copy of the GNU General Public License
+// along with VPixels.  If not, see <https://www.gnu.org/licenses/>.
+////////////////////////////////////////////////////////////////////////
+
+#include "GifSubBlockReader.h"
+#include "Exception.h"
+
+namespace
+{
+  // load 8 bytes as uint64_t, little-endian, see GifCodeReader
+  inline uint64_t Load64( const uint8_t* p )
+  {
+    return  static_cast<uint64_t>(p[0])        | (static_cast<uint64_t>(p[1]) << 8)  |
+           (static_cast<uint64_t>(p[2]) << 16) | (static_cast<uint64_t>(p[3]) << 24) |
+           (static_cast<uint64_t>(p[4]) << 32) | (static_cast<uint64_t>(p[5]) << 40) |
+           (static_cast<uint64_t>(p[6]) << 48) | (static_cast<uint64_t>(p[7]) << 56);
+  }
+}
+
+/////////////////////////////////////////
+// read sub-blocks from buffer, starting with size of 1st sub-block
+///////////////////////////////////////////////////////////////////
+GifSubBlockReader::GifSubBlockReader( const uint8_t* pData, const size_t Size )
+ : m_pData( pData ),
+   m_DataSize( Size ),
+   m_DataIndex( 0 ),
+   m_End( false ),
+   m_pByte( pData ),
+   m_BlockRemaining( 0 ),
+   m_BitCounter( 0 ),
+   m_Buffer( 0 )
+{
+}
+
+//////////////////////////
+// read a code of CodeSize (in bits)
+// throw if there are not enough bits left
+///////////////////////////////////////////////////
+uint16_t GifSubBlockReader::operator()( const uint8_t CodeSize )
+{
+  uint16_t Code;
+  if( !(*this)( CodeSize, Code ) )
+    throw vp::Exception( "no more code" );
+
+  return Code;
+}
+
+//////////////////////////
+// skip the remaining sub-blocks and the terminating byte
+////////////////////////////////////////////////////////////
+void GifSubBlockReader::Skip()
+{
+  while( NextBlock() )
+    ;
+
+  m_BitCounter = 0;
+  m_Buffer = 0;
+}
+
+//////////////////////////
+// add bytes to buffer, so that it has at least CodeSize bits
+// return false if there are not enough bytes left
+///////////////////////////////////////////////////
+bool GifSubBlockReader::Refill( const uint8_t CodeSize )
+{
+  while( m_BitCounter < CodeSize )
+  {
+    if( m_BlockRemaining == 0 && !NextBlock() )
+      return false;
+
+    // far from the end of sub-block, add as many whole bytes as
+    // the buffer can hold with a single 8-byte load
+    if( m_BlockRemaining >= 8 )
+    {
+      uint8_t Bytes = static_cast<uint8_t>((64 - m_BitCounter) >> 3);
+      uint64_t Word = Load64( m_pByte ) & (~0ULL >> (64 - 8*Bytes));
+
+      m_Buffer |= Word << m_BitCounter;
+      m_pByte += Bytes;
+      m_BlockRemaining = static_cast<uint8_t>(m_BlockRemaining - Bytes);
+      m_BitCounter = static_cast<uint8_t>(m_BitCounter + 8*Bytes);
+    }
+    else  // near the end, add one byte
+    {
+      m_Buffer |= static_cast<uint64_t>(*m_pByte++) << m_BitCounter;
+      --m_BlockRemaining;
+      m_BitCounter = static_cast<uint8_t>(m_BitCounter + 8);
+    }
+  }
+
+  return true;
+}
+
+//////////////////////////
+// move to the next sub-block
+// return false at the terminating byte, or if data is truncated
+////////////////////////////////////////////////////////////////
+bool GifSubBlockReader::NextBlock()
+{
+  if( m_End )
+    return false;
+
+  // skip what is left of current sub-block
+  m_pByte += m_BlockRemaining;
+  m_BlockRemaining = 0;
+
+  m_DataIndex = static_cast<size_t>(m_pByte - m_pData);
+  if( m_DataIndex >= m_DataSize || m_pData[m_DataIndex] == 0 )
+  {
+    if( m_DataIndex < m_DataSize )
+      ++m_DataIndex;  // terminating byte
+
+    m_End = true;
+    return false;
+  }
+
+  size_t BlockSize = m_pData[m_DataIndex++];
+  if( BlockSize > m_DataSize - m_DataIndex )
+    BlockSize = m_DataSize - m_DataIndex;  // truncated
+
+  m_pByte = m_pData + m_DataIndex;
+  m_BlockRemaining = static_cast<uint8_t>(BlockSize);
+  m_DataIndex += BlockSize;
+
+  return m_BlockRemaining > 0;
+}
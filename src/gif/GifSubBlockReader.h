@@ -0,0 +1,88 @@
+////////////////////////////////////////////////////////////////////////
+// Copyright (C) 2019 Xueyi Yao
+//
+// This file is part of VPixels.
+//
+// VPixels is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+// 
+// VPixels is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+// 
+// You should have received a copy of the GNU General Public License
+// along with VPixels.  If not, see <https://www.gnu.org/licenses/>.
+////////////////////////////////////////////////////////////////////////
+
+#ifndef GifSubBlockReader_h
+#define GifSubBlockReader_h
+
+#include "U8String.h"
+
+///////////////////
+// Functor that reads codes from a sub-block chain, same as GifCodeReader
+// but without collecting the chain into a string first.
+//
+// Sub-blocks are pulled one at a time from a buffer holding GIF data,
+// e.g. the chain kept by GifImageData or a mapped file. Reading stops
+// at the terminating byte. Call Skip() to move past the rest of the chain
+// after decoding, as EOI code may be followed by more sub-blocks.
+////////////////////////////////////////////////////////////////////////
+class GifSubBlockReader
+{
+public:
+  GifSubBlockReader( const uint8_t* pData, const size_t Size );
+  ~GifSubBlockReader() = default;
+
+  // not implemented
+  GifSubBlockReader( const GifSubBlockReader& ) = delete;
+  GifSubBlockReader( GifSubBlockReader&& ) = delete;
+  GifSubBlockReader& operator=( const GifSubBlockReader& ) = delete;
+  GifSubBlockReader& operator=( GifSubBlockReader&& ) = delete;
+
+  uint16_t operator()( const uint8_t CodeSize );
+  bool     operator()( const uint8_t CodeSize, uint16_t& Code );
+
+  void   Skip();
+  size_t Position() const { return m_DataIndex; }
+
+private:
+  bool Refill( const uint8_t CodeSize );
+  bool NextBlock();
+
+  const uint8_t* m_pData;        // source buffer
+  size_t   m_DataSize;           // size of m_pData
+  size_t   m_DataIndex;          // index to next byte in m_pData
+  bool     m_End;                // reached the end of sub-block chain
+
+  const uint8_t* m_pByte;        // next byte in current sub-block
+  uint8_t  m_BlockRemaining;     // bytes left in current sub-block
+
+  uint8_t  m_BitCounter;         // number of bits in m_Buffer
+  uint64_t m_Buffer;             // codes buffer, bits above m_BitCounter are 0
+};
+
+//////////////////////////
+// read a code of CodeSize (in bits)
+// return false if there are not enough bits left
+///////////////////////////////////////////////////
+inline bool GifSubBlockReader::operator()( const uint8_t CodeSize, uint16_t& Code )
+{
+  // buffer the code
+  if( m_BitCounter < CodeSize && !Refill( CodeSize ) )
+    return false;
+
+  // extract the code
+  Code = static_cast<uint16_t>(m_Buffer & (0xFFFFu >> (16 - CodeSize)));
+
+  // update buffer
+  m_Buffer >>= CodeSize;
+  m_BitCounter = static_cast<uint8_t>(m_BitCounter - CodeSize);
+
+  return true;
+}
+
+#endif //GifSubBlockReader_h
@@ -0,0 +1,184 @@
+////////////////////////////////////////////////////////////////////////
+// Copyright (C) 2019 Xueyi Yao
+//
+// This file is part of VPixels.
+//
+// VPixels is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+// 
+// VPixels is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+// 
+// You should have received a copy of the GNU General Public License
+// along with VPixels.  If not, see <https://www.gnu.org/licenses/>.
+////////////////////////////////////////////////////////////////////////
+
+#include "GifSubBlockWriter.h"
+#include <ostream>
+
+namespace
+{
+  // load 8 bytes as uint64_t, little-endian, see GifSubBlockReader
+  inline uint64_t Load64( const uint8_t* p )
+  {
+    return  static_cast<uint64_t>(p[0])        | (static_cast<uint64_t>(p[1]) << 8)  |
+           (static_cast<uint64_t>(p[2]) << 16) | (static_cast<uint64_t>(p[3]) << 24) |
+           (static_cast<uint64_t>(p[4]) << 32) | (static_cast<uint64_t>(p[5]) << 40) |
+           (static_cast<uint64_t>(p[6]) << 48) | (static_cast<uint64_t>(p[7]) << 56);
+  }
+
+  // store uint64_t as 8 bytes, little-endian, see GifBufferedCodeWriter
+  inline void Store64( uint8_t* p, const uint64_t Word )
+  {
+    p[0] = static_cast<uint8_t>(Word);
+    p[1] = static_cast<uint8_t>(Word >> 8);
+    p[2] = static_cast<uint8_t>(Word >> 16);
+    p[3] = static_cast<uint8_t>(Word >> 24);
+    p[4] = static_cast<uint8_t>(Word >> 32);
+    p[5] = static_cast<uint8_t>(Word >> 40);
+    p[6] = static_cast<uint8_t>(Word >> 48);
+    p[7] = static_cast<uint8_t>(Word >> 56);
+  }
+}
+
+//////////////////////////////////////////
+// write sub-blocks to stream
+//////////////////////////////////////////
+GifSubBlockWriter::GifSubBlockWriter( std::ostream& os )
+ : m_pStream( &os ),
+   m_pBuffer( nullptr ),
+   m_Block(),
+   m_BlockSize( 0 ),
+   m_BitCounter( 0 ),
+   m_Buffer( 0 )
+{
+}
+
+//////////////////////////////////////////
+// append sub-blocks to buffer
+//////////////////////////////////////////
+GifSubBlockWriter::GifSubBlockWriter( U8String& Buffer )
+ : m_pStream( nullptr ),
+   m_pBuffer( &Buffer ),
+   m_Block(),
+   m_BlockSize( 0 ),
+   m_BitCounter( 0 ),
+   m_Buffer( 0 )
+{
+}
+
+/////////////////////////
+// move whole bytes in buffer into sub-block
+/////////////////////////////////////////////////////////////
+void GifSubBlockWriter::Flush()
+{
+  uint8_t Bytes = m_BitCounter >> 3;
+  if( m_BlockSize + 8 <= 255 )
+  {
+    // store all 8 bytes, but only whole bytes are counted
+    Store64( &m_Block[1 + m_BlockSize], m_Buffer );
+    m_BlockSize = static_cast<uint8_t>(m_BlockSize + Bytes);
+    if( m_BlockSize == 255 )
+      WriteBlock();
+  }
+  else  // sub-block is about to be full
+  {
+    for( uint8_t i = 0; i < Bytes; ++i )
+      Put( static_cast<uint8_t>(m_Buffer >> (8*i)) );
+  }
+
+  m_Buffer = (Bytes == 8) ? 0 : (m_Buffer >> (8*Bytes));
+  m_BitCounter = static_cast<uint8_t>(m_BitCounter - 8*Bytes);
+}
+
+/////////////////////////
+// add a byte to sub-block
+/////////////////////////////////////////////////////////////
+void GifSubBlockWriter::Put( const uint8_t Byte )
+{
+  m_Block[1 + m_BlockSize] = Byte;
+  if( ++m_BlockSize == 255 )
+    WriteBlock();
+}
+
+/////////////////////////
+// write sub-block, including its size
+/////////////////////////////////////////////////////////////
+void GifSubBlockWriter::WriteBlock()
+{
+  m_Block[0] = m_BlockSize;
+  if( m_pStream != nullptr )
+    m_pStream->write( reinterpret_cast<const char*>(m_Block), 1 + m_BlockSize );
+  else
+    m_pBuffer->append( m_Block, 1 + m_BlockSize );
+
+  m_BlockSize = 0;
+}
+
+/////////////////////////
+// write Bits bits of codes, packed into bytes as GifBufferedCodeWriter
+// writes them, e.g. the codes of a chunk encoded on its own
+/////////////////////////////////////////////////////////////
+void GifSubBlockWriter::Append( const uint8_t* pCodes, const size_t Bits )
+{
+  // fewer than 8 bits left in buffer, which are put in front of the
+  // codes, shifting them by the same number of bits
+  Flush();
+
+  // far from the end, add 8 bytes of codes at a time, the bits
+  // shifted out are carried over to the next 8 bytes
+  size_t Words = Bits / 64;
+  for( size_t i = 0; i < Words; ++i )
+  {
+    uint64_t Word = Load64( pCodes + 8*i );
+    uint64_t Shifted = m_Buffer | (Word << m_BitCounter);
+    if( m_BlockSize + 8 <= 255 )
+    {
+      Store64( &m_Block[1 + m_BlockSize], Shifted );
+      m_BlockSize = static_cast<uint8_t>(m_BlockSize + 8);
+      if( m_BlockSize == 255 )
+        WriteBlock();
+    }
+    else  // sub-block is about to be full
+    {
+      for( uint8_t b = 0; b < 8; ++b )
+        Put( static_cast<uint8_t>(Shifted >> (8*b)) );
+    }
+
+    m_Buffer = (m_BitCounter == 0) ? 0 : (Word >> (64 - m_BitCounter));
+  }
+
+  // whole bytes, then the bits left
+  size_t Bit = 64*Words;
+  for( ; Bits - Bit >= 8; Bit += 8 )
+    (*this)( pCodes[Bit/8], 8 );
+
+  if( Bit < Bits )
+    (*this)( static_cast<uint16_t>(pCodes[Bit/8] & ((1u << (Bits - Bit)) - 1)),
+             static_cast<uint8_t>(Bits - Bit) );
+}
+
+// end code writing
+void GifSubBlockWriter::End()
+{
+  // whole bytes and the last partial byte
+  while( m_BitCounter > 0 )
+  {
+    Put( static_cast<uint8_t>(m_Buffer) );
+    m_Buffer >>= 8;
+    m_BitCounter = (m_BitCounter > 8) ? static_cast<uint8_t>(m_BitCounter - 8) : 0;
+  }
+
+  if( m_BlockSize > 0 )
+    WriteBlock();
+
+  // terminating byte
+  if( m_pStream != nullptr )
+    m_pStream->put( 0x00 );
+  else
+    m_pBuffer->push_back( 0x00 );
+}
@@ -0,0 +1,79 @@
+////////////////////////////////////////////////////////////////////////
+// Copyright (C) 2019 Xueyi Yao
+//
+// This file is part of VPixels.
+//
+// VPixels is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+// 
+// VPixels is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+// 
+// You should have received a copy of the GNU General Public License
+// along with VPixels.  If not, see <https://www.gnu.org/licenses/>.
+////////////////////////////////////////////////////////////////////////
+
+#ifndef GifSubBlockWriter_h
+#define GifSubBlockWriter_h
+
+#include <iosfwd>
+#include "U8String.h"
+
+// Functor that writes codes as a sub-block chain, same as writing them
+// with GifBufferedCodeWriter and then GifBlockIO::WriteSubBlocks().
+//
+// Codes are collected into a sub-block of 255 bytes, which is written
+// out once it is full, either to a stream or appended to a buffer.
+// End() writes the last sub-block and the terminating byte.
+//////////////////////////////////////////
+class GifSubBlockWriter
+{
+public:
+  explicit GifSubBlockWriter( std::ostream& os );
+  explicit GifSubBlockWriter( U8String& Buffer );
+  ~GifSubBlockWriter() = default;
+
+  // not implemented
+  GifSubBlockWriter( const GifSubBlockWriter& ) = delete;
+  GifSubBlockWriter( GifSubBlockWriter&& ) = delete;
+  GifSubBlockWriter& operator=( const GifSubBlockWriter& ) = delete;
+  GifSubBlockWriter& operator=( GifSubBlockWriter&& ) = delete;
+
+  void operator()( const uint16_t Code, const uint8_t CodeSize );
+  void Append( const uint8_t* pCodes, const size_t Bits );
+  void End();
+
+private:
+  void Flush();
+  void Put( const uint8_t Byte );
+  void WriteBlock();
+
+  std::ostream* m_pStream;    // output stream, or nullptr
+  U8String*     m_pBuffer;    // output buffer, if m_pStream is nullptr
+
+  uint8_t   m_Block[1 + 255 + 8];  // size byte, data, room for 8-byte store
+  uint8_t   m_BlockSize;      // number of bytes in sub-block
+  uint8_t   m_BitCounter;     // number of bits in m_Buffer
+  uint64_t  m_Buffer;         // codes buffer, flushed when it can not
+                              // accommodate another 12-bit code
+};
+
+/////////////////////////
+// write Code of CodeSize (in bits)
+/////////////////////////////////////////////////////////////
+inline void GifSubBlockWriter::operator()( const uint16_t Code, const uint8_t CodeSize )
+{
+  // buffer the code
+  m_Buffer |= static_cast<uint64_t>(Code) << m_BitCounter;
+  m_BitCounter = static_cast<uint8_t>(m_BitCounter + CodeSize);
+
+  // flush whole bytes, if next code may not fit
+  if( m_BitCounter > 52 )
+    Flush();
+}
+
+#endif //GifSubBlockWriter_h
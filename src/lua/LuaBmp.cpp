@@ -18,6 +18,7 @@
 ////////////////////////////////////////////////////////////////////////
 
 #include <lua.hpp>
+#include <vector>
 #include "LuaBmp.h"
 #include "LuaUtil.h"
 #include "Bmp.h"
@@ -35,6 +36,8 @@ namespace LuaBmpImpl
   int Clone( lua_State* L );
   int Import( lua_State* L );
   int Export( lua_State* L );
+  int ImportString( lua_State* L );
+  int ExportString( lua_State* L );
   int BitsPerPixel( lua_State* L );
   int Width( lua_State* L );
   int Height( lua_State* L );
@@ -63,6 +66,8 @@ namespace LuaBmpImpl
     { "clone",          Clone },
     { "import",         Import },
     { "export",         Export },
+    { "importstring",   ImportString },
+    { "exportstring",   ExportString },
     { "bitsperpixel",   BitsPerPixel },
     { "bpp",            BitsPerPixel },
     { "width",          Width },
@@ -241,6 +246,56 @@ int LuaBmpImpl::Export( lua_State* L )
   return 0;
 }
 
+///////////////////
+// bmp:ImportString( data )
+//////////////////////////////////
+int LuaBmpImpl::ImportString( lua_State* L ) 
+{
+  LuaUtil::CheckArgs( L, 2 );
+
+  vp::Bmp* pBmp = CheckBmp( L, 1 );
+
+  size_t Size = 0;
+  const char* Data = luaL_checklstring( L, 2, &Size );
+
+  bool Error = false;
+  try
+  {
+    pBmp->Import( reinterpret_cast<const uint8_t*>(Data), Size );
+  }
+  catch( const vp::Exception& e )
+  {
+    // error occurred during importing
+    Error = true;
+
+    // No exception safety, see Import()
+    luaL_where( L, 1 );
+    lua_pushfstring( L, "failed to import data (%s)", e.what() );
+    lua_concat( L, 2 );
+  }
+
+  if( Error )
+    return lua_error( L );  // exception caught
+  else
+    return 0;  // data successfully imported
+}
+
+///////////////////
+// data = bmp:ExportString()
+//////////////////////////////////
+int LuaBmpImpl::ExportString( lua_State* L ) 
+{
+  LuaUtil::CheckArgs( L, 1 );
+
+  vp::Bmp* pBmp = CheckBmp( L, 1 );
+
+  std::vector<uint8_t> Data;
+  pBmp->ExportTo( Data );
+
+  lua_pushlstring( L, reinterpret_cast<const char*>(Data.data()), Data.size() );
+  return 1;
+}
+
 ////////////
 // bpp = bmp:BitsPerPixel()
 ///////////////////////////////
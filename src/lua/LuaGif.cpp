@@ -18,6 +18,7 @@
 ////////////////////////////////////////////////////////////////////////
 
 #include <lua.hpp>
+#include <vector>
 #include "LuaGif.h"
 #include "LuaGifDefs.h"
 #include "LuaUtil.h"
@@ -37,6 +38,8 @@ namespace LuaGifImpl
   int Clone( lua_State* L );
   int Import( lua_State* L );
   int Export( lua_State* L );
+  int ImportString( lua_State* L );
+  int ExportString( lua_State* L );
   int Version( lua_State* L );
   int BitsPerPixel( lua_State* L );
   int Width( lua_State* L );
@@ -78,6 +81,8 @@ namespace LuaGifImpl
     { "clone",          Clone },
     { "import",         Import },
     { "export",         Export },
+    { "importstring",   ImportString },
+    { "exportstring",   ExportString },
     { "version",        Version },
     { "bitsperpixel",   BitsPerPixel },
     { "bpp",            BitsPerPixel },
@@ -275,6 +280,61 @@ int LuaGifImpl::Export( lua_State* L )
   return 0;
 }
 
+///////////////////
+// gif:ImportString( data )
+//////////////////////////////////
+int LuaGifImpl::ImportString( lua_State* L ) 
+{
+  LuaUtil::CheckArgs( L, 2 );
+
+  LuaGifUD* pGifUD = CheckGifUD( L, 1 );
+  CheckGif( L, pGifUD->pGif,  1 );
+
+  size_t Size = 0;
+  const char* Data = luaL_checklstring( L, 2, &Size );
+
+  bool Error = false;
+  try
+  {
+    pGifUD->pGif->Import( reinterpret_cast<const uint8_t*>(Data), Size );
+  }
+  catch( const vp::Exception& e )
+  {
+    // error occurred during importing
+    Error = true;
+
+    // No exception safety, see Import()
+    luaL_where( L, 1 );
+    lua_pushfstring( L, "failed to import data (%s)", e.what() );
+    lua_concat( L, 2 );
+  }
+
+  // reset the list, no matter whether importing failed or not
+  Invalidate( pGifUD->pListImageUD );
+  pGifUD->pListImageUD->Clear();
+
+  if( Error )
+    return lua_error( L );  // exception caught
+  else
+    return 0;  // data successfully imported
+}
+
+///////////////////
+// data = gif:ExportString()
+//////////////////////////////////
+int LuaGifImpl::ExportString( lua_State* L ) 
+{
+  LuaUtil::CheckArgs( L, 1 );
+
+  vp::Gif* pGif = CheckGif( L, 1 );
+
+  std::vector<uint8_t> Data;
+  pGif->ExportTo( Data );
+
+  lua_pushlstring( L, reinterpret_cast<const char*>(Data.data()), Data.size() );
+  return 1;
+}
+
 ////////////
 // v = gif:Version()
 //////////////////////////////////
@@ -406,14 +406,25 @@ int LuaGifImageImpl::Transparent( lua_State* L )
 
 /////////////////
 // ret_bool = image:Interlaced()
+// image:Interlaced( bool )
 //////////////////////////////////
 int LuaGifImageImpl::Interlaced( lua_State* L )
 {
-  LuaUtil::CheckArgs( L, 1 );
-  vp::GifImage* pGifImage = CheckGifImage( L, 1 );
-  lua_pushboolean( L, pGifImage->Interlaced() );
+  auto argc = LuaUtil::CheckArgs( L, 1, 1 );
+  auto pGifImage = CheckGifImage( L, 1 );
+  if( argc == 1 )
+  {
+    lua_pushboolean( L, pGifImage->Interlaced() );
 
-  return 1;  
+    return 1;
+  }
+  else
+  {
+    bool Interlace = LuaUtil::CheckBoolean( L, 2 );
+    pGifImage->Interlaced( Interlace );
+
+    return 0;
+  }
 }
 
 ///////////////////////
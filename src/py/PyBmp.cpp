@@ -18,6 +18,7 @@
 ////////////////////////////////////////////////////////////////////////
 
 #include <Python.h>
+#include <vector>
 #include "PyBmp.h"
 #include "PyUtil.h"
 #include "Bmp.h"
@@ -56,6 +57,16 @@ PyDoc_STRVAR( export_doc,
    overwrite: if True, overwrite existing file, default == False\n\n\
 Export " PACKAGE_NAME ".bmp object to a BMP file." );
 
+PyDoc_STRVAR( importbytes_doc,
+"importbytes(data)\n\n\
+   data: content of a BMP file, as a string of bytes\n\n\
+Import BMP data in memory into " PACKAGE_NAME ".bmp object.");
+
+PyDoc_STRVAR( exportbytes_doc,
+"exportbytes() -> str\n\n\
+Return content of the BMP file that " PACKAGE_NAME ".bmp object would be\n\
+exported to, as a string of bytes." );
+
 PyDoc_STRVAR( clone_doc,
 "clone() -> " PACKAGE_NAME ".bmp\n\n\
 Create a new " PACKAGE_NAME ".bmp object that is the same as the current one." );
@@ -170,6 +181,8 @@ namespace PyBmpImpl
   // methods of Bmp_Type (exposed to Python)
   PyObject* Import( PyBmpObject* self, PyObject* arg );
   PyObject* Export( PyBmpObject* self, PyObject* args );
+  PyObject* ImportBytes( PyBmpObject* self, PyObject* arg );
+  PyObject* ExportBytes( PyBmpObject* self, PyObject* );
   PyObject* Clone( PyBmpObject* self, PyObject* );
   PyObject* BitsPerPixel( PyBmpObject* self, PyObject* );
   PyObject* Width( PyBmpObject* self, PyObject* );
@@ -190,6 +203,8 @@ namespace PyBmpImpl
     // cannot use 'import' as name, which causes SyntaxError
     MDef( importf,        Import,         METH_O,       importf_doc )
     MDef( export,         Export,         METH_VARARGS, export_doc )
+    MDef( importbytes,    ImportBytes,    METH_O,       importbytes_doc )
+    MDef( exportbytes,    ExportBytes,    METH_NOARGS,  exportbytes_doc )
     MDef( clone,          Clone,          METH_NOARGS,  clone_doc )
     MDef( bitsperpixel,   BitsPerPixel,   METH_NOARGS,  bitsperpixel_doc )
     MDef( bpp,            BitsPerPixel,   METH_NOARGS,  bpp_doc )
@@ -410,6 +425,50 @@ PyObject* PyBmpImpl::Export( PyBmpObject* self, PyObject* args )
   Py_RETURN_NONE;
 }
 
+//////////////////////
+// bmp.ImportBytes( data )
+//////////////////////////////////////////////////////
+PyObject* PyBmpImpl::ImportBytes( PyBmpObject* self, PyObject* arg )
+{
+  if( !PyString_CheckExact(arg) )
+  {
+    PyErr_Format( PyExc_TypeError, "requires string argument, not %s",
+                  Py_TYPE(arg)->tp_name );
+    return nullptr;    
+  }
+
+  char* Data = nullptr;
+  Py_ssize_t Size = 0;
+  if( PyString_AsStringAndSize( arg, &Data, &Size ) < 0 )
+    return nullptr;
+
+  try
+  {
+    self->pBmp->Import( reinterpret_cast<const uint8_t*>(Data),
+                        static_cast<size_t>(Size) );
+  }
+  catch( const vp::Exception& e )
+  {
+    // No exception safety, see Import()
+    PyErr_Format( PyExc_Exception, "failed to import data (%s)", e.what() );
+    return nullptr;
+  }
+
+  Py_RETURN_NONE;
+}
+
+////////////////////////
+// data = bmp.ExportBytes()
+//////////////////////////////////////////////////////
+PyObject* PyBmpImpl::ExportBytes( PyBmpObject* self, PyObject* )
+{
+  std::vector<uint8_t> Data;
+  self->pBmp->ExportTo( Data );
+
+  return PyString_FromStringAndSize( reinterpret_cast<const char*>(Data.data()),
+                                     static_cast<Py_ssize_t>(Data.size()) );
+}
+
 /////////////////////
 // bmp2 = bmp1.Clone()
 //////////////////////////////////////////
@@ -18,6 +18,7 @@
 ////////////////////////////////////////////////////////////////////////
 
 #include <Python.h>
+#include <vector>
 #include "PyGif.h"
 #include "PyGifDefs.h"
 #include "PyUtil.h"
@@ -66,6 +67,16 @@ PyDoc_STRVAR( export_doc,
    overwrite: if True, overwrite existing file, default == False\n\n\
 Export " PACKAGE_NAME ".gif object to a GIF file." );
 
+PyDoc_STRVAR( importbytes_doc,
+"importbytes(data)\n\n\
+   data: content of a GIF file, as a string of bytes\n\n\
+Import GIF data in memory into " PACKAGE_NAME ".gif object.");
+
+PyDoc_STRVAR( exportbytes_doc,
+"exportbytes() -> str\n\n\
+Return content of the GIF file that " PACKAGE_NAME ".gif object would be\n\
+exported to, as a string of bytes." );
+
 PyDoc_STRVAR( clone_doc,
 "clone() -> " PACKAGE_NAME ".gif\n\n\
 Create a new " PACKAGE_NAME ".gif object that is the same as the current one." );
@@ -194,6 +205,8 @@ namespace PyGifImpl
   // methods for Gif_Type (exposed to Python)
   PyObject* Import( PyGifObject* self, PyObject* arg );
   PyObject* Export( PyGifObject* self, PyObject* args );
+  PyObject* ImportBytes( PyGifObject* self, PyObject* arg );
+  PyObject* ExportBytes( PyGifObject* self, PyObject* );
   PyObject* Clone( PyGifObject* self, PyObject* );
   PyObject* Version( PyGifObject* self, PyObject* );
   PyObject* BitsPerPixel( PyGifObject* self, PyObject* args );
@@ -228,6 +241,8 @@ namespace PyGifImpl
     // cannot use 'import' as name, which causes SyntaxError
     MDef( importf,          Import,           METH_O,       importf_doc )
     MDef( export,           Export,           METH_VARARGS, export_doc )
+    MDef( importbytes,      ImportBytes,      METH_O,       importbytes_doc )
+    MDef( exportbytes,      ExportBytes,      METH_NOARGS,  exportbytes_doc )
     MDef( clone,            Clone,            METH_NOARGS,  clone_doc )
     MDef( version,          Version,          METH_NOARGS,  version_doc )
     MDef( bitsperpixel,     BitsPerPixel,     METH_VARARGS, bitsperpixel_doc )
@@ -503,6 +518,56 @@ PyObject* PyGifImpl::Export( PyGifObject* self, PyObject* args )
   Py_RETURN_NONE;
 }
 
+///////////////////
+// gif.ImportBytes( data )
+//////////////////////////////////////////////////////
+PyObject* PyGifImpl::ImportBytes( PyGifObject* self, PyObject* arg )
+{
+  if( !PyString_CheckExact(arg) )
+  {
+    PyErr_Format( PyExc_TypeError, "requires string argument, not %s",
+                  Py_TYPE(arg)->tp_name );
+    return nullptr;    
+  }
+
+  char* Data = nullptr;
+  Py_ssize_t Size = 0;
+  if( PyString_AsStringAndSize( arg, &Data, &Size ) < 0 )
+    return nullptr;
+
+  try
+  {
+    self->pGif->Import( reinterpret_cast<const uint8_t*>(Data),
+                        static_cast<size_t>(Size) );
+  }
+  catch( const vp::Exception& e )
+  {
+    // No exception safety, see Import()
+    PyErr_Format( PyExc_Exception, "failed to import data (%s)", e.what() );
+  }
+
+  // reset the list, no matter whether importing failed or not
+  Invalidate( self->pGifImageObjectList );
+  self->pGifImageObjectList->Clear();
+
+  if( PyErr_Occurred() == nullptr )
+    Py_RETURN_NONE;  // data successfully imported
+  else
+    return nullptr;  // exception caught
+}
+
+///////////////////
+// data = gif.ExportBytes()
+//////////////////////////////////////////////////////
+PyObject* PyGifImpl::ExportBytes( PyGifObject* self, PyObject* )
+{
+  std::vector<uint8_t> Data;
+  self->pGif->ExportTo( Data );
+
+  return PyString_FromStringAndSize( reinterpret_cast<const char*>(Data.data()),
+                                     static_cast<Py_ssize_t>(Data.size()) );
+}
+
 ///////////////////
 // gif2 = gif1.Clone()
 //////////////////////////////////////////
@@ -140,7 +140,9 @@ Return True if pixel is transparent, else False." );
 PyDoc_STRVAR( trans_doc, "Alias of transparent(...)" );
 
 PyDoc_STRVAR( interlaced_doc,
-"interlaced() -> bool\n\n\
+"interlaced(switch)\n\n\
+Write pixels interlaced on export if switch == True, else not.\n\n\
+interlaced() -> bool\n\n\
 Return True if pixels are interlaced, else False.");
 
 PyDoc_STRVAR( delay_doc,
@@ -243,7 +245,7 @@ namespace PyGifImageImpl
   PyObject* SetPixel( PyGifImageObject* self, PyObject* args );
   PyObject* GetPixel( PyGifImageObject* self, PyObject* args );
   PyObject* Transparent( PyGifImageObject* self, PyObject* args );
-  PyObject* Interlaced( PyGifImageObject* self, PyObject* );
+  PyObject* Interlaced( PyGifImageObject* self, PyObject* args );
   PyObject* Delay( PyGifImageObject* self, PyObject* args );
   PyObject* ColorTable( PyGifImageObject* self, PyObject* );
   PyObject* ColorTableSorted( PyGifImageObject* self, PyObject* );
@@ -274,7 +276,7 @@ namespace PyGifImageImpl
     MDef( getpixel,         GetPixel,         METH_VARARGS, getpixel_doc )
     MDef( transparent,      Transparent,      METH_VARARGS, transparent_doc )
     MDef( trans,            Transparent,      METH_VARARGS, trans_doc )
-    MDef( interlaced,       Interlaced,       METH_NOARGS,  interlaced_doc )
+    MDef( interlaced,       Interlaced,       METH_VARARGS, interlaced_doc )
     MDef( delay,            Delay,            METH_VARARGS, delay_doc )
     MDef( colortable,       ColorTable,       METH_NOARGS,  colortable_doc )
     MDef( colortablesorted, ColorTableSorted, METH_NOARGS,  colortablesorted_doc )
@@ -699,14 +701,29 @@ PyObject* PyGifImageImpl::Transparent( PyGifImageObject* self, PyObject* args )
 
 ///////////////////
 // ret_bool = img.Interlaced()
+// img.Interlaced( bool )
 ///////////////////////////////////////////////////
-PyObject* PyGifImageImpl::Interlaced( PyGifImageObject* self, PyObject* )
+PyObject* PyGifImageImpl::Interlaced( PyGifImageObject* self, PyObject* args )
 {
   GifImage_Check( self )
-  if( self->pGifImage->Interlaced() )
-    Py_RETURN_TRUE;
+
+  if( PyTuple_Size( args ) == 0 )
+  {
+    if( self->pGifImage->Interlaced() )
+      Py_RETURN_TRUE;
+    else
+      Py_RETURN_FALSE;
+  }
   else
-    Py_RETURN_FALSE;
+  {
+    PyObject* pyBool = Py_False;
+    if( !PyArg_ParseTuple(args, "O!", &PyBool_Type, &pyBool) )
+      return nullptr;
+
+    self->pGifImage->Interlaced( PyObject_IsTrue( pyBool ) );
+
+    Py_RETURN_NONE;
+  }
 }
 
 ///////////////////
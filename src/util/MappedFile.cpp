@@ -0,0 +1,95 @@
+////////////////////////////////////////////////////////////////////////
+// Copyright (C) 2019 Xueyi Yao
+//
+// This file is part of VPixels.
+//
+// VPixels is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+// 
+// VPixels is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+// 
+// You should have received a copy of the GNU General Public License
+// along with VPixels.  If not, see <https://www.gnu.org/licenses/>.
+////////////////////////////////////////////////////////////////////////
+
+#include "MappedFile.h"
+#include <fstream>
+
+#ifndef _WIN32
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+/////////////////////////
+// map the file, or read it if it can not be mapped
+/////////////////////////////////////////////////////////////////
+MappedFile::MappedFile( const std::string& FileName )
+ : m_Open( false ),
+   m_Mapped( false ),
+   m_pData( nullptr ),
+   m_Size( 0 ),
+   m_Buffer()
+{
+#ifndef _WIN32
+  int fd = open( FileName.c_str(), O_RDONLY );
+  if( fd < 0 )
+    return;
+
+  struct stat Stat;
+  if( fstat( fd, &Stat ) == 0 && S_ISREG(Stat.st_mode) )
+  {
+    m_Open = true;
+    m_Size = static_cast<size_t>(Stat.st_size);
+
+    // an empty file can not be mapped, and need not be
+    if( m_Size > 0 )
+    {
+      void* p = mmap( nullptr, m_Size, PROT_READ, MAP_PRIVATE, fd, 0 );
+      if( p != MAP_FAILED )
+      {
+        m_pData = static_cast<const uint8_t*>(p);
+        m_Mapped = true;
+      }
+    }
+  }
+  close( fd );
+
+  if( m_Mapped || (m_Open && m_Size == 0) )
+    return;
+#endif
+
+  m_Open = ReadFile( FileName );
+}
+
+/////////////////////////
+MappedFile::~MappedFile()
+{
+#ifndef _WIN32
+  if( m_Mapped )
+    munmap( const_cast<uint8_t*>(m_pData), m_Size );
+#endif
+}
+
+/////////////////////////
+// read the whole file into m_Buffer
+/////////////////////////////////////////////////////////////////
+bool MappedFile::ReadFile( const std::string& FileName )
+{
+  std::ifstream File( FileName, std::ios::binary );
+  if( !File.is_open() )
+    return false;
+
+  m_Buffer.assign( std::istreambuf_iterator<char>(File),
+                   std::istreambuf_iterator<char>() );
+  m_pData = m_Buffer.data();
+  m_Size = m_Buffer.size();
+
+  return true;
+}
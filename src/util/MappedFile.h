@@ -0,0 +1,63 @@
+////////////////////////////////////////////////////////////////////////
+// Copyright (C) 2019 Xueyi Yao
+//
+// This file is part of VPixels.
+//
+// VPixels is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+// 
+// VPixels is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+// 
+// You should have received a copy of the GNU General Public License
+// along with VPixels.  If not, see <https://www.gnu.org/licenses/>.
+////////////////////////////////////////////////////////////////////////
+
+#ifndef MappedFile_h
+#define MappedFile_h
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+//////////////////////////////
+// A read-only file mapped into memory
+// Used by GifImpl::Import() to parse a file without reading it into
+// a buffer first. The sub-blocks of image data are still copied out
+// of it, see GifImageData.
+// If the file can not be mapped, e.g. on Windows, it is read into
+// memory instead.
+////////////////////////////////////////////////////////////////
+class MappedFile
+{
+public:
+  explicit MappedFile( const std::string& FileName );
+  ~MappedFile();
+
+  // not implemented
+  MappedFile( const MappedFile& ) = delete;
+  MappedFile( MappedFile&& ) = delete;
+  MappedFile& operator=( const MappedFile& ) = delete;
+  MappedFile& operator=( MappedFile&& ) = delete;
+
+  // false if the file does not exist or can not be read
+  explicit operator bool() const { return m_Open; }
+
+  const uint8_t* Data() const { return m_pData; }
+  size_t         Size() const { return m_Size; }
+
+private:
+  bool ReadFile( const std::string& FileName );
+
+  bool           m_Open;
+  bool           m_Mapped;   // m_pData points to mapped memory
+  const uint8_t* m_pData;
+  size_t         m_Size;
+  std::vector<uint8_t> m_Buffer;  // file content, if not mapped
+};
+
+#endif //MappedFile_h
@@ -0,0 +1,146 @@
+////////////////////////////////////////////////////////////////////////
+// Copyright (C) 2019 Xueyi Yao
+//
+// This file is part of VPixels.
+//
+// VPixels is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+// 
+// VPixels is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+// 
+// You should have received a copy of the GNU General Public License
+// along with VPixels.  If not, see <https://www.gnu.org/licenses/>.
+////////////////////////////////////////////////////////////////////////
+
+#ifndef MemoryBuf_h
+#define MemoryBuf_h
+
+#include <cstdint>
+#include <streambuf>
+#include <vector>
+
+//////////////////////////////
+// A read-only stream buffer over bytes in memory, e.g. a mapped file
+// Reading from an std::istream attached to it involves no copying
+// into an intermediate buffer. Current() and Advance() give direct
+// access to the bytes for those who can use them without the stream.
+////////////////////////////////////////////////////////////////
+class MemoryBuf : public std::streambuf
+{
+public:
+  MemoryBuf( const uint8_t* pData, const size_t Size )
+  {
+    char* p = const_cast<char*>(reinterpret_cast<const char*>(pData));
+    setg( p, p, p + Size );
+  }
+
+  ~MemoryBuf() = default;
+
+  // not implemented
+  MemoryBuf( const MemoryBuf& ) = delete;
+  MemoryBuf( MemoryBuf&& ) = delete;
+  MemoryBuf& operator=( const MemoryBuf& ) = delete;
+  MemoryBuf& operator=( MemoryBuf&& ) = delete;
+
+  // bytes not read yet
+  const uint8_t* Current() const
+  {
+    return reinterpret_cast<const uint8_t*>(gptr());
+  }
+
+  size_t Remaining() const
+  {
+    return static_cast<size_t>(egptr() - gptr());
+  }
+
+  // skip Size bytes, at most up to the end
+  void Advance( size_t Size )
+  {
+    if( Size > Remaining() )
+      Size = Remaining();
+
+    setg( eback(), gptr() + Size, egptr() );
+  }
+
+protected:
+  // support tellg() and seekg()
+  pos_type seekoff( off_type Offset, std::ios_base::seekdir Dir,
+                    std::ios_base::openmode Mode = std::ios_base::in ) override
+  {
+    if( !(Mode & std::ios_base::in) )
+      return pos_type( off_type(-1) );
+
+    char* Base = (Dir == std::ios_base::beg) ? eback() :
+                 (Dir == std::ios_base::cur) ? gptr() : egptr();
+    if( Offset < eback() - Base || Offset > egptr() - Base )
+      return pos_type( off_type(-1) );
+
+    setg( eback(), Base + Offset, egptr() );
+    return pos_type( gptr() - eback() );
+  }
+
+  pos_type seekpos( pos_type Pos,
+                    std::ios_base::openmode Mode = std::ios_base::in ) override
+  {
+    return seekoff( off_type(Pos), std::ios_base::beg, Mode );
+  }
+};
+
+//////////////////////////////
+// A write-only stream buffer that appends to std::vector<uint8_t>
+// Writing to an std::ostream attached to it goes straight into
+// the vector, without an intermediate string as std::ostringstream.
+////////////////////////////////////////////////////////////////
+class VectorBuf : public std::streambuf
+{
+public:
+  explicit VectorBuf( std::vector<uint8_t>& Data )
+   : m_Data( Data )
+  {
+  }
+
+  ~VectorBuf() = default;
+
+  // not implemented
+  VectorBuf( const VectorBuf& ) = delete;
+  VectorBuf( VectorBuf&& ) = delete;
+  VectorBuf& operator=( const VectorBuf& ) = delete;
+  VectorBuf& operator=( VectorBuf&& ) = delete;
+
+protected:
+  int_type overflow( int_type Char ) override
+  {
+    if( !traits_type::eq_int_type( Char, traits_type::eof() ) )
+      m_Data.push_back( static_cast<uint8_t>(Char) );
+
+    return traits_type::not_eof( Char );
+  }
+
+  std::streamsize xsputn( const char* pChars, std::streamsize Count ) override
+  {
+    const uint8_t* p = reinterpret_cast<const uint8_t*>(pChars);
+    m_Data.insert( m_Data.end(), p, p + Count );
+
+    return Count;
+  }
+
+  // support tellp()
+  pos_type seekoff( off_type Offset, std::ios_base::seekdir Dir,
+                    std::ios_base::openmode Mode = std::ios_base::out ) override
+  {
+    if( Offset != 0 || Dir != std::ios_base::cur || !(Mode & std::ios_base::out) )
+      return pos_type( off_type(-1) );
+
+    return pos_type( static_cast<off_type>(m_Data.size()) );
+  }
+
+private:
+  std::vector<uint8_t>& m_Data;
+};
+
+#endif //MemoryBuf_h
@@ -0,0 +1,117 @@
+////////////////////////////////////////////////////////////////////////
+// Copyright (C) 2019 Xueyi Yao
+//
+// This file is part of VPixels.
+//
+// VPixels is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+// 
+// VPixels is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+// 
+// You should have received a copy of the GNU General Public License
+// along with VPixels.  If not, see <https://www.gnu.org/licenses/>.
+////////////////////////////////////////////////////////////////////////
+
+#ifndef ParallelFor_h
+#define ParallelFor_h
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <exception>
+#include <mutex>
+#include <system_error>
+#include <thread>
+#include <vector>
+
+//////////////////////////////
+// Run independent jobs, e.g. decoding the images of a GIF, on a
+// number of threads. The calling thread takes part, so no thread is
+// started if only one is needed.
+////////////////////////////////////////////////////////////////
+namespace Parallel
+{
+  //////////////////////////////////
+  // number of threads to use, 0 means one per hardware thread
+  ////////////////////////////////////////////////////////////
+  inline unsigned Threads( const unsigned Requested )
+  {
+    if( Requested != 0 )
+      return Requested;
+
+    return std::max( 1u, std::thread::hardware_concurrency() );
+  }
+
+  //////////////////////////////////
+  // Call Func(i) for i = 0, 1, ... Count - 1 on up to Threads threads.
+  // Indices are handed out one by one, so a thread that finishes a
+  // cheap job early takes the next one. If Func throws, jobs not yet
+  // started are skipped, and the first exception is rethrown once all
+  // threads have finished.
+  ////////////////////////////////////////////////////////////
+  template<typename F>
+  void For( const size_t Count, const unsigned Threads, F Func )
+  {
+    size_t Workers = std::min( static_cast<size_t>(Parallel::Threads(Threads)), Count );
+    if( Workers <= 1 )
+    {
+      for( size_t i = 0; i < Count; ++i )
+        Func( i );
+
+      return;
+    }
+
+    std::atomic<size_t> Next( 0 );
+    std::exception_ptr  pError;
+    std::mutex          ErrorMutex;
+
+    auto Work = [&]()
+    {
+      size_t i;
+      while( (i = Next++) < Count )
+      {
+        try
+        {
+          Func( i );
+        }
+        catch( ... )
+        {
+          std::lock_guard<std::mutex> Lock( ErrorMutex );
+          if( !pError )
+            pError = std::current_exception();
+
+          Next = Count;  // stop handing out jobs
+        }
+      }
+    };
+
+    std::vector<std::thread> Pool;
+    Pool.reserve( Workers - 1 );
+    for( size_t t = 1; t < Workers; ++t )
+    {
+      try
+      {
+        Pool.emplace_back( Work );
+      }
+      catch( const std::system_error& )
+      {
+        break;  // run with the threads already started
+      }
+    }
+
+    Work();
+    for( auto& Thread : Pool )
+      Thread.join();
+
+    if( pError )
+      std::rethrow_exception( pError );
+  }
+
+} // namespace Parallel
+
+#endif //ParallelFor_h
@@ -17,6 +17,8 @@
 // along with VPixels.  If not, see <https://www.gnu.org/licenses/>.
 ////////////////////////////////////////////////////////////////////////
 
+#include <sstream>
+#include <vector>
 #include "BmpTest.h"
 #include "Bmp.h"
 #include "Exception.h"
@@ -370,4 +372,39 @@ void BmpTest::testExport()
 
   // export to new file
   CPPUNIT_ASSERT( bmp.Export( "export_new.bmp" ) );
-}
\ No newline at end of file
+}
+// Import(), ImportFrom() and ExportTo() in memory
+void BmpTest::testMemoryIO()
+{
+  vp::Bmp bmp( 24, 7, 5 );
+  bmp.SetPixel( 6, 4, 10, 20, 30 );
+
+  std::vector<uint8_t> Data;
+  bmp.ExportTo( Data );
+  CPPUNIT_ASSERT( Data.size() == 54 + 24*5 );  // 7 pixels padded to 24 bytes/row
+  CPPUNIT_ASSERT( Data[0] == 'B' && Data[1] == 'M' );
+
+  std::ostringstream os;
+  bmp.ExportTo( os );
+  CPPUNIT_ASSERT( os.str() == std::string( Data.begin(), Data.end() ) );
+
+  vp::Bmp bmp1;
+  bmp1.Import( Data.data(), Data.size() );
+  CPPUNIT_ASSERT( bmp1.BitsPerPixel() == 24 );
+  CPPUNIT_ASSERT( bmp1.Width() == 7 );
+  CPPUNIT_ASSERT( bmp1.Height() == 5 );
+  uint8_t B, G, R;
+  bmp1.GetPixel( 6, 4, B, G, R );
+  CPPUNIT_ASSERT( B == 10 && G == 20 && R == 30 );
+
+  vp::Bmp bmp2;
+  std::istringstream is( os.str() );
+  bmp2.ImportFrom( is );
+  bmp2.GetPixel( 6, 4, B, G, R );
+  CPPUNIT_ASSERT( B == 10 && G == 20 && R == 30 );
+
+  // not valid
+  vp::Bmp bmp3;
+  CPPUNIT_ASSERT_THROW( bmp3.Import( nullptr, 0 ), vp::Exception );
+  CPPUNIT_ASSERT_THROW( bmp3.Import( Data.data(), Data.size() - 10 ), vp::Exception );
+}
@@ -37,6 +37,7 @@ class BmpTest : public CPPUNIT_NS::TestCase
 
   CPPUNIT_TEST( testImport );
   CPPUNIT_TEST( testExport );
+  CPPUNIT_TEST( testMemoryIO );
 
   CPPUNIT_TEST_SUITE_END();
 
@@ -48,6 +49,7 @@ protected:
   void test24Bits();
   void testImport();
   void testExport();
+  void testMemoryIO();
 };
 
 #endif //BmpTest_h
@@ -0,0 +1,1192 @@
+////////////////////////////////////////////////////////////////////////
+// Copyright (C) 2019 Xueyi Yao
+//
+// This file is part of VPixels.
+//
+// VPixels is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+// 
+// VPixels is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+// 
+// You should have received a copy of the GNU General Public License
+// along with VPixels.  If not, see <https://www.gnu.org/licenses/>.
+////////////////////////////////////////////////////////////////////////
+// Benchmarks of the GIF codec.
+//
+// Usage: GifBenchmark [NAME ...]
+// Run all benchmarks if no name is given.
+
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <vector>
+#include "GifCodeReader.h"
+#include "GifCodeWriter.h"
+#include "GifBufferedCodeWriter.h"
+#include "GifDecoder.h"
+#include "GifEncoder.h"
+#include "GifFastDecoder.h"
+#include "GifSubBlockReader.h"
+#include "GifSubBlockWriter.h"
+#include "GifBlockIO.h"
+#include "GifImpl.h"
+#include "GifImage.h"
+#include "GifImageVecBuilder.h"
+#include "GifRenderer.h"
+#include "Gif.h"
+#include "Exception.h"
+
+// directory of sample images, defined by build system
+#ifndef VP_IMAGE_DIR
+#define VP_IMAGE_DIR "."
+#endif
+
+namespace
+{
+  ///////////////////////
+  // run Func Repeat times, return the best time in milliseconds
+  ///////////////////////////////////////////////////////////////
+  template<typename F>
+  double Time( F Func, const int Repeat = 5 )
+  {
+    double Best = 0;
+    for( int i = 0; i < Repeat; ++i )
+    {
+      auto Start = std::chrono::steady_clock::now();
+      Func();
+      std::chrono::duration<double, std::milli> Elapsed =
+        std::chrono::steady_clock::now() - Start;
+
+      if( i == 0 || Elapsed.count() < Best )
+        Best = Elapsed.count();
+    }
+
+    return Best;
+  }
+
+  ///////////////////////
+  void Report( const std::string& Case, const double Milliseconds )
+  {
+    std::cout << "  " << std::left << std::setw(40) << Case
+              << std::right << std::setw(10) << std::fixed
+              << std::setprecision(3) << Milliseconds << " ms" << std::endl;
+  }
+
+  ///////////////////////
+  // Generate a frame of Width x Height pixels of Bpp, consisting of
+  // runs of random length and color, so that it compresses like
+  // real images do
+  ///////////////////////////////////////////////////////////////
+  U8String Frame( const uint8_t Bpp, const size_t Width, const size_t Height )
+  {
+    U8String Pixels;
+    Pixels.reserve( Width*Height );
+    while( Pixels.size() < Width*Height )
+    {
+      size_t Run = std::min( static_cast<size_t>(rand() % 16 + 1),
+                             Width*Height - Pixels.size() );
+      Pixels.append( Run, static_cast<uint8_t>(rand() % (1 << Bpp)) );
+    }
+
+    return Pixels;
+  }
+
+  ///////////////////////
+  // Generate a flat frame of Width x Height pixels, bpp = 8, e.g. of a
+  // screen capture: Rects rectangles of solid colors on a background,
+  // which compresses far better than Frame()
+  ///////////////////////////////////////////////////////////////
+  U8String FlatFrame( const size_t Width, const size_t Height, const int Rects )
+  {
+    U8String Pixels( Width*Height, 0 );
+    for( int r = 0; r < Rects; ++r )
+    {
+      size_t Left = static_cast<size_t>(rand()) % Width;
+      size_t Top = static_cast<size_t>(rand()) % Height;
+      size_t Right = std::min( Width, Left + static_cast<size_t>(rand()) % (Width/3) + 1 );
+      size_t Bottom = std::min( Height, Top + static_cast<size_t>(rand()) % (Height/3) + 1 );
+      uint8_t Color = static_cast<uint8_t>(rand() % 256);
+      for( size_t y = Top; y < Bottom; ++y )
+        std::fill( &Pixels[y*Width + Left], &Pixels[y*Width + Right], Color );
+    }
+
+    return Pixels;
+  }
+
+  ///////////////////////
+  // Pixels of all frames of a sample GIF file, bpp = 8
+  ///////////////////////////////////////////////////////////////
+  std::vector<U8String> SampleFrames()
+  {
+    std::vector<U8String> Frames;
+
+    GifImpl Gif;
+    std::string FileName = std::string(VP_IMAGE_DIR) + "/rainyday.gif";
+    if( !Gif.Import( FileName ) )
+    {
+      std::cout << "  failed to open " << FileName << std::endl;
+      return Frames;
+    }
+
+    for( size_t i = 0; i < Gif.Images(); ++i )
+    {
+      const vp::GifImage& Image = Gif[i];
+      U8String Pixels;
+      for( uint16_t y = 0; y < Image.Height(); ++y )
+        for( uint16_t x = 0; x < Image.Width(); ++x )
+          Pixels += Image.GetPixel( x, y );
+      Frames.push_back( Pixels );
+    }
+
+    return Frames;
+  }
+
+  ///////////////////////
+  // Encode pixels into codes without EOI code, as many GIF files do.
+  // Only single pixel codes are written, under the same code size
+  // schedule as the decoder follows.
+  ///////////////////////////////////////////////////////////////
+  U8String EOILessCodes( const uint8_t Bpp, const U8String& Pixels )
+  {
+    const uint16_t ClearCode = 1 << Bpp;
+
+    U8String Codes;
+    GifCodeWriter WriteCode( Codes );
+
+    uint8_t  CodeSize  = Bpp + 1;
+    uint16_t CodeLimit = 1 << CodeSize;
+    uint16_t FreeCode  = ClearCode + 2;
+    WriteCode( ClearCode, CodeSize );
+    for( size_t i = 0; i < Pixels.size(); ++i )
+    {
+      WriteCode( Pixels[i], CodeSize );
+      if( i > 0 && FreeCode < 4096 )
+        ++FreeCode;
+
+      if( FreeCode == CodeLimit && CodeSize < 12 )
+      {
+        ++CodeSize;
+        CodeLimit <<= 1;
+      }
+    }
+    WriteCode.End();
+
+    return Codes;
+  }
+
+  ///////////////////////
+  // Decode small frames that have no EOI code. Compare reading codes
+  // until an exception is thrown with reading codes until false is returned.
+  ///////////////////////////////////////////////////////////////
+  void EOILessFrames()
+  {
+    std::cout << "EOI-less frames (10000 frames of 16x16, bpp = 4)" << std::endl;
+
+    srand( 1 );
+    std::vector<U8String> Frames;
+    for( int n = 0; n < 10000; ++n )
+    {
+      U8String Pixels;
+      for( int i = 0; i < 16*16; ++i )
+        Pixels += static_cast<uint8_t>(rand() % 16);
+      Frames.push_back( EOILessCodes(4, Pixels) );
+    }
+
+    size_t Sum = 0;
+    Report( "read codes, end by exception", Time( [&]() {
+      for( auto& Codes : Frames )
+      {
+        GifCodeReader ReadCode( Codes );
+        try
+        {
+          while( true )
+            Sum += ReadCode( 5 );
+        }
+        catch( const vp::Exception& )
+        {
+        }
+      }
+    } ) );
+
+    Report( "read codes, end by status", Time( [&]() {
+      for( auto& Codes : Frames )
+      {
+        GifCodeReader ReadCode( Codes );
+        uint16_t Code;
+        while( ReadCode(5, Code) )
+          Sum += Code;
+      }
+    } ) );
+
+    GifDecoder Decoder;
+    Report( "GifDecoder", Time( [&]() {
+      for( auto& Codes : Frames )
+      {
+        U8String Pixels;
+        Decoder( 4, Codes, Pixels );
+        Sum += Pixels.size();
+      }
+    } ) );
+
+    GifFastDecoder FastDecoder;
+    Report( "GifFastDecoder", Time( [&]() {
+      for( auto& Codes : Frames )
+      {
+        U8String Pixels;
+        FastDecoder( 4, Codes, Pixels );
+        Sum += Pixels.size();
+      }
+    } ) );
+
+    // keep the results alive
+    if( Sum == 0 )
+      std::cout << std::endl;
+  }
+
+  ///////////////////////
+  // Read codes from and decode a large frame
+  ///////////////////////////////////////////////////////////////
+  void LargeFrame()
+  {
+    std::cout << "Large frame (4096x4096, bpp = 8)" << std::endl;
+
+    srand( 1 );
+    U8String Pixels = Frame( 8, 4096, 4096 );
+    U8String Codes;
+    GifEncoder Encoder;
+    Encoder( 8, Pixels, Codes );
+
+    size_t Sum = 0;
+    Report( "read 12-bit codes", Time( [&]() {
+      GifCodeReader ReadCode( Codes );
+      uint16_t Code;
+      while( ReadCode(12, Code) )
+        Sum += Code;
+    } ) );
+
+    GifDecoder Decoder;
+    Report( "GifDecoder", Time( [&]() {
+      U8String Decoded;
+      Decoded.reserve( Pixels.size() );
+      Decoder( 8, Codes, Decoded );
+      Sum += Decoded.size();
+    } ) );
+
+    GifFastDecoder FastDecoder;
+    Report( "GifFastDecoder", Time( [&]() {
+      U8String Decoded;
+      Decoded.reserve( Pixels.size() );
+      FastDecoder( 8, Codes, Decoded );
+      Sum += Decoded.size();
+    } ) );
+
+    if( Sum == 0 )
+      std::cout << std::endl;
+  }
+
+  ///////////////////////
+  // Write codes of and encode a large frame
+  ///////////////////////////////////////////////////////////////
+  void EncodeLargeFrame()
+  {
+    std::cout << "Encode large frame (4096x4096, bpp = 8)" << std::endl;
+
+    srand( 1 );
+    U8String Pixels = Frame( 8, 4096, 4096 );
+
+    size_t Sum = 0;
+    Report( "GifCodeWriter, 12-bit codes", Time( [&]() {
+      U8String Codes;
+      Codes.reserve( Pixels.size() );
+      GifCodeWriter WriteCode( Codes );
+      for( size_t i = 0; i < Pixels.size()/2; ++i )
+        WriteCode( static_cast<uint16_t>(i & 0x0FFF), 12 );
+      WriteCode.End();
+      Sum += Codes.size();
+    } ) );
+
+    Report( "GifBufferedCodeWriter, 12-bit codes", Time( [&]() {
+      U8String Codes;
+      Codes.reserve( Pixels.size() );
+      GifBufferedCodeWriter WriteCode( Codes );
+      for( size_t i = 0; i < Pixels.size()/2; ++i )
+        WriteCode( static_cast<uint16_t>(i & 0x0FFF), 12 );
+      WriteCode.End();
+      Sum += Codes.size();
+    } ) );
+
+    GifEncoder Encoder;
+    Report( "GifEncoder", Time( [&]() {
+      U8String Codes;
+      Codes.reserve( Pixels.size() );
+      Encoder( 8, Pixels, Codes );
+      Sum += Codes.size();
+    } ) );
+
+    if( Sum == 0 )
+      std::cout << std::endl;
+  }
+
+  ///////////////////////
+  // Encode sample frames, reduced to bpp of 2, 3, ... 8, using
+  // GifEncoder with each of the string tables
+  ///////////////////////////////////////////////////////////////
+  void Dictionary()
+  {
+    std::cout << "String tables (rainyday.gif, x20)" << std::endl;
+
+    std::vector<U8String> Frames = SampleFrames();
+    size_t Sum = 0;
+    for( uint8_t Bpp = 2; Bpp <= 8; ++Bpp )
+    {
+      // drop low bits of color index
+      std::vector<U8String> Reduced( Frames );
+      for( auto& Pixels : Reduced )
+        for( auto& Pixel : Pixels )
+          Pixel = static_cast<uint8_t>(Pixel >> (8 - Bpp));
+
+      const std::pair<const char*, GifDictionary> Tables[] = {
+        { "hashed", GifDictionary::Hashed },
+        { "direct", GifDictionary::Direct }
+      };
+      for( auto& Table : Tables )
+      {
+        // an encoder per frame, as GifImageData does
+        Report( "bpp = " + std::to_string(Bpp) + ", " + Table.first, Time( [&]() {
+          for( int n = 0; n < 20; ++n )
+          {
+            for( auto& Pixels : Reduced )
+            {
+              U8String Codes;
+              Codes.reserve( Pixels.size() );
+              GifEncoder Encoder( Table.second );
+              Encoder( Bpp, Pixels, Codes );
+              Sum += Codes.size();
+            }
+          }
+        } ) );
+      }
+    }
+
+    if( Sum == 0 )
+      std::cout << std::endl;
+  }
+
+  ///////////////////////
+  // Encode many tiny frames with one encoder, where resetting
+  // the string table is a large part of the work
+  ///////////////////////////////////////////////////////////////
+  void EncodeTinyFrames()
+  {
+    std::cout << "Encode tiny frames (bpp = 8, x10000)" << std::endl;
+
+    size_t Sum = 0;
+    const std::pair<const char*, GifDictionary> Tables[] = {
+      { "hashed", GifDictionary::Hashed },
+      { "direct", GifDictionary::Direct }
+    };
+    const size_t Sizes[] = { 4, 8, 16 };
+    for( size_t Size : Sizes )
+    {
+      srand( 1 );
+      std::vector<U8String> Frames;
+      for( int i = 0; i < 10000; ++i )
+        Frames.push_back( Frame( 8, Size, Size ) );
+
+      for( auto& Table : Tables )
+      {
+        GifEncoder Encoder( Table.second );
+        std::string Case = std::to_string(Size) + "x" + std::to_string(Size) +
+                           ", " + Table.first;
+        Report( Case, Time( [&]() {
+          U8String Codes;
+          for( auto& Pixels : Frames )
+          {
+            Codes.clear();
+            Encoder( 8, Pixels, Codes );
+            Sum += Codes.size();
+          }
+        } ) );
+      }
+    }
+
+    if( Sum == 0 )
+      std::cout << std::endl;
+  }
+
+  ///////////////////////
+  // Encode a large frame into a sub-block chain and decode it, either
+  // through the whole code string or sub-block by sub-block
+  ///////////////////////////////////////////////////////////////
+  void SubBlocks()
+  {
+    std::cout << "Sub-blocks (4096x4096, bpp = 8)" << std::endl;
+
+    srand( 1 );
+    U8String Pixels = Frame( 8, 4096, 4096 );
+    U8String Codes;
+    GifEncoder Encoder;
+    Encoder( 8, Pixels, Codes );
+
+    std::ostringstream os;
+    GifBlockIO::WriteSubBlocks( os, Codes );
+    const std::string Chain = os.str();
+
+    size_t Sum = 0;
+    Report( "GifEncoder + WriteSubBlocks", Time( [&]() {
+      std::ostringstream os;
+      U8String Data;
+      Data.reserve( Pixels.size() );
+      Encoder( 8, Pixels, Data );
+      GifBlockIO::WriteSubBlocks( os, Data );
+      Sum += os.str().size();
+    } ) );
+
+    Report( "GifSubBlockWriter (stream)", Time( [&]() {
+      std::ostringstream os;
+      GifSubBlockWriter WriteCode( os );
+      Encoder( 8, Pixels, WriteCode );
+      Sum += os.str().size();
+    } ) );
+
+    Report( "GifSubBlockWriter (buffer)", Time( [&]() {
+      U8String Buffer;
+      GifSubBlockWriter WriteCode( Buffer );
+      Encoder( 8, Pixels, WriteCode );
+      Sum += Buffer.size();
+    } ) );
+
+    Report( "ReadSubBlocks + GifFastDecoder", Time( [&]() {
+      std::istringstream is( Chain );
+      U8String Data, Output;
+      Output.reserve( Pixels.size() );
+      GifBlockIO::ReadSubBlocks( is, Data );
+      GifFastDecoder Decoder;
+      Decoder( 8, Data, Output );
+      Sum += Output.size();
+    } ) );
+
+    Report( "GifSubBlockReader", Time( [&]() {
+      U8String Output;
+      Output.reserve( Pixels.size() );
+      GifSubBlockReader ReadCode( reinterpret_cast<const uint8_t*>(Chain.data()),
+                                  Chain.size() );
+      GifFastDecoder Decoder;
+      Decoder( 8, ReadCode, Output );
+      Sum += Output.size();
+    } ) );
+
+    if( Sum == 0 )
+      std::cout << std::endl;
+  }
+
+  ///////////////////////
+  // Import a GIF file by reading it from std::ifstream, or by parsing
+  // it in place after mapping it into memory (GifImpl::Import)
+  ///////////////////////////////////////////////////////////////
+  void ImportFile( const std::string& FileName )
+  {
+    size_t Sum = 0;
+    Report( "std::ifstream", Time( [&]() {
+      GifImpl Gif;
+      std::ifstream File( FileName, std::ios::binary );
+      Gif.Read( File );
+      Gif.m_ImageVec = GifImageVecBuilder()( Gif, Gif.m_ComponentVec );
+      Gif.Decode();
+      Sum += Gif.Images();
+    } ) );
+
+    Report( "mapped", Time( [&]() {
+      GifImpl Gif;
+      Gif.Import( FileName );
+      Sum += Gif.Images();
+    } ) );
+
+    for( unsigned Threads : { 2u, 4u, 8u } )
+    {
+      Report( "mapped, " + std::to_string(Threads) + " threads", Time( [&]() {
+        GifImpl Gif;
+        Gif.Threads( Threads );
+        Gif.Import( FileName );
+        Sum += Gif.Images();
+      } ) );
+    }
+
+    Report( "mapped, lazy", Time( [&]() {
+      GifImpl Gif;
+      Gif.Import( FileName, true );
+      for( size_t i = 0; i < Gif.Images(); ++i )
+        Sum += Gif[i].Delay();
+    } ) );
+
+    if( Sum == 0 )
+      std::cout << std::endl;
+  }
+
+  void Import()
+  {
+    std::cout << "Import rainyday.gif (280x176, 10 frames)" << std::endl;
+    ImportFile( std::string(VP_IMAGE_DIR) + "/rainyday.gif" );
+
+    // large animation
+    srand( 1 );
+    GifImpl Gif( 8, 1024, 1024, 20 );
+    for( size_t i = 0; i < Gif.Images(); ++i )
+    {
+      vp::GifImage& Image = Gif[i];
+      U8String Pixels = Frame( 8, 1024, 1024 );
+      for( uint16_t y = 0; y < 1024; ++y )
+        for( uint16_t x = 0; x < 1024; ++x )
+          Image.SetPixel( x, y, Pixels[static_cast<size_t>(y)*1024 + x] );
+    }
+    Gif.Export( "benchmark_import.gif", true );
+
+    std::cout << "Import large file (1024x1024, 20 frames)" << std::endl;
+    ImportFile( "benchmark_import.gif" );
+    std::remove( "benchmark_import.gif" );
+  }
+
+  ///////////////////////
+  // export an animation whose frames all changed
+  //////////////////////////////////////////////////////////////
+  void Export()
+  {
+    srand( 1 );
+    GifImpl Gif( 8, 1024, 1024, 20 );
+    std::vector<U8String> Frames;
+    for( size_t i = 0; i < Gif.Images(); ++i )
+      Frames.push_back( Frame( 8, 1024, 1024 ) );
+
+    std::cout << "Export changed frames (1024x1024, 20 frames)" << std::endl;
+    size_t Sum = 0;
+    for( unsigned Threads : { 1u, 2u, 4u, 8u } )
+    {
+      Gif.Threads( Threads );
+      Report( std::to_string(Threads) + " thread(s)", Time( [&]() {
+        for( size_t i = 0; i < Gif.Images(); ++i )
+        {
+          vp::GifImage& Image = Gif[i];
+          const U8String& Pixels = Frames[(i + Sum) % Frames.size()];
+          for( uint16_t y = 0; y < 1024; ++y )
+            for( uint16_t x = 0; x < 1024; ++x )
+              Image.SetPixel( x, y, Pixels[static_cast<size_t>(y)*1024 + x] );
+        }
+
+        std::vector<uint8_t> Output;
+        Gif.ExportTo( Output );
+        Sum += Output.size();
+      } ) );
+    }
+
+    if( Sum == 0 )
+      std::cout << std::endl;
+  }
+
+  ///////////////////////
+  // encode a large frame in chunks on multiple threads,
+  // and the cost in size of the clear codes between chunks
+  //////////////////////////////////////////////////////////////
+  void SplitFrame()
+  {
+    // each chunk restarts the string table, which costs more of the
+    // size the better a frame compresses
+    srand( 1 );
+    struct { const char* Name; U8String Pixels; } Frames[] = {
+      { "runs", Frame( 8, 4096, 4096 ) },
+      { "flat", FlatFrame( 4096, 4096, 40 ) },
+      { "nearly solid", FlatFrame( 4096, 4096, 4 ) }
+    };
+
+    for( const auto& Each : Frames )
+    {
+      std::cout << "Encode large frame in chunks (4096x4096, bpp = 8, "
+                << Each.Name << ")" << std::endl;
+
+      const U8String& Pixels = Each.Pixels;
+      size_t Serial = 0;
+      for( unsigned Threads : { 1u, 2u, 4u, 8u, 16u } )
+      {
+        GifEncoder Encoder( GifDictionary::Auto, Threads );
+        size_t Size = 0;
+        double Milliseconds = Time( [&]() {
+          U8String Codes;
+          Codes.reserve( Pixels.size() );
+          Encoder( 8, Pixels, Codes );
+          Size = Codes.size();
+        } );
+
+        if( Threads == 1 )
+          Serial = Size;
+
+        std::ostringstream Case;
+        Case << Threads << " thread(s), " << Size << " bytes, "
+             << std::showpos << std::fixed << std::setprecision(3)
+             << 100.0 * (static_cast<double>(Size) / static_cast<double>(Serial) - 1.0) << "%";
+        Report( Case.str(), Milliseconds );
+      }
+    }
+  }
+
+  ///////////////////////
+  // import and export a large frame, interlaced or not
+  //////////////////////////////////////////////////////////////
+  void Interlace()
+  {
+    std::cout << "Import and export large frame (4096x4096, bpp = 8)" << std::endl;
+
+    srand( 1 );
+    GifImpl Source( 8, 4096, 4096, 1 );
+    U8String Pixels = Frame( 8, 4096, 4096 );
+    for( uint16_t y = 0; y < 4096; ++y )
+      for( uint16_t x = 0; x < 4096; ++x )
+        Source[0].SetPixel( x, y, Pixels[static_cast<size_t>(y)*4096 + x] );
+
+    size_t Sum = 0;
+    for( bool Interlaced : { false, true } )
+    {
+      std::string Mode = Interlaced? "interlaced" : "not interlaced";
+      Source[0].Interlaced( Interlaced );
+      std::vector<uint8_t> Data;
+      Source.ExportTo( Data );
+
+      GifImpl Gif;
+      Report( "import, " + Mode, Time( [&]() {
+        Gif.Import( Data.data(), Data.size() );
+        Sum += Gif[0].GetPixel( 0, 0 );
+      } ) );
+
+      Report( "export, " + Mode, Time( [&]() {
+        Gif[0].SetPixel( 0, 0, static_cast<uint8_t>(Gif[0].GetPixel( 0, 0 ) + 1) );
+        std::vector<uint8_t> Output;
+        Gif.ExportTo( Output );
+        Sum += Output.size();
+      } ) );
+    }
+
+    if( Sum == 0 )
+      std::cout << std::endl;
+  }
+
+  ///////////////////////
+  // copy pixels of a large frame out of and into an image,
+  // pixel by pixel, row by row, or from Data()
+  //////////////////////////////////////////////////////////////
+  void BulkPixels()
+  {
+    std::cout << "Copy pixels of large frame (4096x4096, bpp = 8)" << std::endl;
+
+    srand( 1 );
+    GifImpl Gif( 8, 4096, 4096, 1 );
+    vp::GifImage& Image = Gif[0];
+    U8String Pixels = Frame( 8, 4096, 4096 );
+    U8String Out( Pixels.size(), 0 );
+
+    size_t Sum = 0;
+    Report( "SetPixel()", Time( [&]() {
+      for( uint16_t y = 0; y < 4096; ++y )
+        for( uint16_t x = 0; x < 4096; ++x )
+          Image.SetPixel( x, y, Pixels[static_cast<size_t>(y)*4096 + x] );
+    } ) );
+
+    Report( "SetRow()", Time( [&]() {
+      for( uint16_t y = 0; y < 4096; ++y )
+        Image.SetRow( y, &Pixels[static_cast<size_t>(y)*4096] );
+    } ) );
+
+    Report( "SetRect(), whole image", Time( [&]() {
+      Image.SetRect( 0, 0, 4096, 4096, Pixels.data() );
+    } ) );
+
+    Report( "GetPixel()", Time( [&]() {
+      for( uint16_t y = 0; y < 4096; ++y )
+        for( uint16_t x = 0; x < 4096; ++x )
+          Out[static_cast<size_t>(y)*4096 + x] = Image.GetPixel( x, y );
+      Sum += Out[4097];
+    } ) );
+
+    Report( "GetRow()", Time( [&]() {
+      for( uint16_t y = 0; y < 4096; ++y )
+        Image.GetRow( y, &Out[static_cast<size_t>(y)*4096] );
+      Sum += Out[4097];
+    } ) );
+
+    Report( "Data()", Time( [&]() {
+      const uint8_t* pData = Image.Data();
+      for( size_t i = 0; i < Out.size(); ++i )
+        Sum += pData[i];
+    } ) );
+
+    if( Sum == 0 )
+      std::cout << std::endl;
+  }
+
+  ///////////////////////
+  // convert color indices of a large frame into colors
+  //////////////////////////////////////////////////////////////
+  void Colors()
+  {
+    std::cout << "Colors of large frame (4096x4096, bpp = 8)" << std::endl;
+
+    srand( 1 );
+    GifImpl Gif( 8, 4096, 4096, 1 );
+    for( uint16_t i = 0; i < 256; ++i )
+      Gif.SetColorTable( static_cast<uint8_t>(i), static_cast<uint8_t>(i),
+                         static_cast<uint8_t>(255 - i), static_cast<uint8_t>(i/2) );
+    vp::GifImage& Image = Gif[0];
+    U8String Pixels = Frame( 8, 4096, 4096 );
+    Image.SetRect( 0, 0, 4096, 4096, Pixels.data() );
+    std::vector<uint8_t> Out( Pixels.size()*4 );
+
+    size_t Sum = 0;
+    Report( "GetPixel(), RGB", Time( [&]() {
+      uint8_t* p = Out.data();
+      for( uint16_t y = 0; y < 4096; ++y )
+        for( uint16_t x = 0; x < 4096; ++x, p += 3 )
+          Image.GetPixel( x, y, p[0], p[1], p[2] );
+      Sum += Out[4097];
+    } ) );
+
+    Report( "GetRGB()", Time( [&]() {
+      Image.GetRGB( Out.data() );
+      Sum += Out[4097];
+    } ) );
+
+    Report( "GetRGBA()", Time( [&]() {
+      Image.GetRGBA( Out.data() );
+      Sum += Out[4097];
+    } ) );
+
+    if( Sum == 0 )
+      std::cout << std::endl;
+  }
+
+  ///////////////////////
+  // crop a large frame, pixel by pixel column-major as Crop() used to,
+  // and by Crop() moving rows in place
+  //////////////////////////////////////////////////////////////
+  void Crop()
+  {
+    std::cout << "Crop large frame (4096x4096 to 4000x4000, bpp = 8)" << std::endl;
+
+    srand( 1 );
+    U8String Pixels = Frame( 8, 4096, 4096 );
+
+    size_t Sum = 0;
+    Report( "GetPixel()/SetPixel(), column-major", Time( [&]() {
+      GifImpl Source( 8, 4096, 4096, 1 );
+      Source[0].SetRect( 0, 0, 4096, 4096, Pixels.data() );
+      GifImpl Target( 8, 4000, 4000, 1 );
+      for( uint16_t x = 0; x < 4000; ++x )
+        for( uint16_t y = 0; y < 4000; ++y )
+          Target[0].SetPixel( x, y, Source[0].GetPixel( x + 50, y + 50 ) );
+      Sum += Target[0].GetPixel( 1, 1 );
+    } ) );
+
+    Report( "Crop(), in place", Time( [&]() {
+      GifImpl Source( 8, 4096, 4096, 1 );
+      Source[0].SetRect( 0, 0, 4096, 4096, Pixels.data() );
+      Source[0].Crop( 50, 50, 4000, 4000 );
+      Sum += Source[0].GetPixel( 1, 1 );
+    } ) );
+
+    Report( "set pixels only, for reference", Time( [&]() {
+      GifImpl Source( 8, 4096, 4096, 1 );
+      Source[0].SetRect( 0, 0, 4096, 4096, Pixels.data() );
+      Sum += Source[0].GetPixel( 1, 1 );
+    } ) );
+
+    if( Sum == 0 )
+      std::cout << std::endl;
+  }
+
+  ///////////////////////
+  // render all frames of an animation of small moving images
+  //////////////////////////////////////////////////////////////
+  void Render()
+  {
+    srand( 1 );
+    vp::Gif Gif( 8, 512, 512, 200 );
+    Gif[0].SetRect( 0, 0, 512, 512, Frame( 8, 512, 512 ).data() );
+    for( size_t i = 1; i < Gif.Images(); ++i )
+    {
+      vp::GifImage& Image = Gif[i];
+      Image.Crop( static_cast<uint16_t>(rand() % 448), static_cast<uint16_t>(rand() % 448), 64, 64 );
+      Image.SetRect( 0, 0, 64, 64, Frame( 8, 64, 64 ).data() );
+      Image.TransColor( 0 );
+      Image.DisposalMethod( static_cast<uint8_t>(i % 4) );
+    }
+
+    size_t Frames = Gif.Images();
+    std::cout << "Render frames as RGBA (512x512, 64x64 images, "
+              << Frames << " frames)" << std::endl;
+
+    size_t Sum = 0;
+    Report( "GetPixel()/Transparent(), in order", Time( [&]() {
+      std::vector<uint8_t> Canvas( 4*static_cast<size_t>(Gif.Width())*Gif.Height(), 0 );
+      for( size_t i = 0; i < Frames; ++i )
+      {
+        const vp::GifImage& Image = Gif[i];
+        for( uint16_t y = 0; y < Image.Height(); ++y )
+          for( uint16_t x = 0; x < Image.Width(); ++x )
+          {
+            if( Image.Transparent( x, y ) )
+              continue;
+
+            uint8_t* p = &Canvas[4*((static_cast<size_t>(y) + Image.Top())*Gif.Width() +
+                                    x + Image.Left())];
+            Image.GetPixel( x, y, p[0], p[1], p[2] );
+            p[3] = 255;
+          }
+        Sum += Canvas[4*i];
+      }
+    }, 1 ) );
+
+    Report( "Render(), in order", Time( [&]() {
+      vp::GifRenderer Renderer( Gif );
+      for( size_t i = 0; i < Frames; ++i )
+        Sum += Renderer.Render( i )[4*i];
+    }, 1 ) );
+
+    Report( "Render(), reversed, keyframes every 16", Time( [&]() {
+      vp::GifRenderer Renderer( Gif );
+      Renderer.Render( Frames - 1 );
+      for( size_t i = Frames; i-- > 0; )
+        Sum += Renderer.Render( i )[4*i];
+    }, 1 ) );
+
+    Report( "Render(), reversed, no keyframes", Time( [&]() {
+      vp::GifRenderer Renderer( Gif, false, 0 );
+      Renderer.Render( Frames - 1 );
+      for( size_t i = Frames; i-- > 0; )
+        Sum += Renderer.Render( i )[4*i];
+    }, 1 ) );
+
+    if( Sum == 0 )
+      std::cout << std::endl;
+  }
+
+  ///////////////////////
+  // optimize full frames of an animation that change in small areas
+  //////////////////////////////////////////////////////////////
+  void OptimizeFrames()
+  {
+    srand( 1 );
+    vp::Gif Source( 8, 512, 512, 60 );
+    U8String Pixels = Frame( 8, 512, 512 );
+    for( size_t i = 0; i < Source.Images(); ++i )
+    {
+      // a few areas change
+      for( int n = 0; n < 3 && i > 0; ++n )
+      {
+        size_t x0 = static_cast<size_t>(rand() % 448), y0 = static_cast<size_t>(rand() % 448);
+        U8String Patch = Frame( 8, 64, 64 );
+        for( size_t y = 0; y < 64; ++y )
+          std::memcpy( &Pixels[(y0 + y)*512 + x0], &Patch[y*64], 64 );
+      }
+      Source[i].SetRect( 0, 0, 512, 512, Pixels.data() );
+    }
+
+    std::vector<uint8_t> Data;
+    Source.ExportTo( Data );
+    std::cout << "Optimize frames for export (512x512, 60 frames, "
+              << Data.size() << " bytes)" << std::endl;
+
+    size_t Sum = 0;
+    Report( "GetPixel(), bounding boxes only", Time( [&]() {
+      for( size_t i = 1; i < Source.Images(); ++i )
+      {
+        uint16_t x0 = 512, x1 = 0, y0 = 512, y1 = 0;
+        for( uint16_t y = 0; y < 512; ++y )
+          for( uint16_t x = 0; x < 512; ++x )
+          {
+            uint8_t R0, G0, B0, R1, G1, B1;
+            Source[i - 1].GetPixel( x, y, R0, G0, B0 );
+            Source[i].GetPixel( x, y, R1, G1, B1 );
+            if( R0 != R1 || G0 != G1 || B0 != B1 )
+            {
+              x0 = std::min( x0, x );
+              x1 = std::max( x1, x );
+              y0 = std::min( y0, y );
+              y1 = y;
+            }
+          }
+        Sum += static_cast<size_t>(x0) + x1 + y0 + y1;
+      }
+    }, 1 ) );
+
+    vp::Gif Optimized;
+    Report( "OptimizeFrames()", Time( [&]() {
+      Optimized = Source;
+      Sum += Optimized.OptimizeFrames();
+    }, 1 ) );
+
+    Optimized.ExportTo( Data );
+    std::cout << "  exported: " << Data.size() << " bytes" << std::endl;
+
+    if( Sum == 0 )
+      std::cout << std::endl;
+  }
+
+  ///////////////////////
+  // find repeated frames of a screen capture, where frames that differ
+  // differ only in a corner
+  //////////////////////////////////////////////////////////////
+  void RemoveDuplicates()
+  {
+    srand( 1 );
+    vp::Gif Source( 8, 640, 480, 120 );
+    for( size_t i = 0; i < 256; ++i )
+      Source.SetColorTable( static_cast<uint8_t>(i), static_cast<uint8_t>(i),
+                            static_cast<uint8_t>(i), static_cast<uint8_t>(i) );
+
+    U8String Pixels = Frame( 8, 640, 480 );
+    for( size_t i = 0; i < Source.Images(); ++i )
+    {
+      // the clock in the bottom right corner ticks every 4 frames
+      if( i % 4 == 0 )
+        Pixels[Pixels.size() - 1 - i/4] ^= 1;
+
+      Source[i].SetRect( 0, 0, 640, 480, Pixels.data() );
+    }
+
+    std::cout << "Find repeated frames (640x480, 120 frames, 90 repeated)" << std::endl;
+
+    size_t Sum = 0;
+    Report( "operator==", Time( [&]() {
+      vp::Gif Gif = Source;
+      for( size_t i = 1; i < Gif.Images(); ++i )
+        Sum += (Gif[i - 1] == Gif[i]);
+    }, 1 ) );
+
+    Report( "Hash(), then operator==", Time( [&]() {
+      vp::Gif Gif = Source;
+      for( size_t i = 1; i < Gif.Images(); ++i )
+        Sum += (Gif[i - 1].Hash() == Gif[i].Hash() && Gif[i - 1] == Gif[i]);
+    }, 1 ) );
+
+    Report( "Hash() only", Time( [&]() {
+      vp::Gif Gif = Source;
+      for( size_t i = 1; i < Gif.Images(); ++i )
+        Sum += (Gif[i - 1].Hash() == Gif[i].Hash());
+    }, 1 ) );
+
+    if( Sum != 3*90 )
+      std::cout << "  mismatch: " << Sum << std::endl;
+  }
+
+  ///////////////////////
+  // compare equal frames, of the same color table, of color tables
+  // different at the transparent color, and of different color tables
+  //////////////////////////////////////////////////////////////
+  void Compare()
+  {
+    srand( 1 );
+    vp::Gif Gif( 8, 1024, 1024, 4 );
+    for( size_t i = 0; i < 256; ++i )
+      Gif.SetColorTable( static_cast<uint8_t>(i), static_cast<uint8_t>(i),
+                         static_cast<uint8_t>(i), static_cast<uint8_t>(i) );
+
+    // not shown, so that all frames are equal
+    Gif[1].TransColor( 255 );
+    U8String Pixels = Frame( 8, 1024, 1024 );
+    std::replace( Pixels.begin(), Pixels.end(), static_cast<uint8_t>(255), static_cast<uint8_t>(254) );
+    for( size_t i = 0; i < 3; ++i )
+      Gif[i].SetRect( 0, 0, 1024, 1024, Pixels.data() );
+
+    // color table in reverse order, and the indices reversed
+    Gif[3].ColorTableSize( 256 );
+    for( size_t i = 0; i < 256; ++i )
+    {
+      uint8_t c = static_cast<uint8_t>(255 - i);
+      Gif[3].SetColorTable( static_cast<uint8_t>(i), c, c, c );
+    }
+
+    for( auto& Index : Pixels )
+      Index = static_cast<uint8_t>(255 - Index);
+    Gif[3].SetRect( 0, 0, 1024, 1024, Pixels.data() );
+
+    std::cout << "Compare equal frames (1024x1024)" << std::endl;
+
+    size_t Sum = 0;
+    auto PixelByPixel = [&]( const vp::GifImage& A, const vp::GifImage& B ) {
+      for( uint16_t y = 0; y < A.Height(); ++y )
+        for( uint16_t x = 0; x < A.Width(); ++x )
+        {
+          if( A.Transparent( x, y ) != B.Transparent( x, y ) )
+            return false;
+
+          uint8_t R1, G1, B1, R2, G2, B2;
+          A.GetPixel( x, y, R1, G1, B1 );
+          B.GetPixel( x, y, R2, G2, B2 );
+          if( R1 != R2 || G1 != G2 || B1 != B2 )
+            return false;
+        }
+      return true;
+    };
+
+    Report( "GetPixel(), the same color table", Time( [&]() {
+      Sum += PixelByPixel( Gif[0], Gif[2] );
+    }, 1 ) );
+
+    Report( "operator==, the same color table", Time( [&]() {
+      Sum += (Gif[0] == Gif[2]);
+    } ) );
+
+    Report( "operator==, a transparent color", Time( [&]() {
+      Sum += (Gif[0] == Gif[1]);
+    } ) );
+
+    Report( "operator==, different color tables", Time( [&]() {
+      Sum += (Gif[0] == Gif[3]);
+    } ) );
+
+    if( Sum == 0 )
+      std::cout << std::endl;
+  }
+
+  ///////////////////////
+  // export an imported animation with only its delays changed
+  //////////////////////////////////////////////////////////////
+  void Rewrite()
+  {
+    srand( 1 );
+    GifImpl Source( 8, 1024, 1024, 20 );
+    for( size_t i = 0; i < Source.Images(); ++i )
+    {
+      vp::GifImage& Image = Source[i];
+      U8String Pixels = Frame( 8, 1024, 1024 );
+      for( uint16_t y = 0; y < 1024; ++y )
+        for( uint16_t x = 0; x < 1024; ++x )
+          Image.SetPixel( x, y, Pixels[static_cast<size_t>(y)*1024 + x] );
+    }
+    std::vector<uint8_t> Data;
+    Source.ExportTo( Data );
+
+    std::cout << "Export after changing delays (1024x1024, 20 frames)" << std::endl;
+    size_t Sum = 0;
+    Report( "re-encoded", Time( [&]() {
+      GifImpl Gif;
+      Gif.Import( Data.data(), Data.size() );
+      std::vector<uint8_t> Output;
+      for( size_t i = 0; i < Gif.Images(); ++i )
+      {
+        Gif[i].Delay( 10 );
+        Gif[i].SetPixel( 0, 0, static_cast<uint8_t>(Gif[i].GetPixel( 0, 0 ) + 1) );
+        Gif[i].SetPixel( 0, 0, static_cast<uint8_t>(Gif[i].GetPixel( 0, 0 ) - 1) );
+      }
+      Gif.ExportTo( Output );
+      Sum += Output.size();
+    } ) );
+
+    Report( "unchanged", Time( [&]() {
+      GifImpl Gif;
+      Gif.Import( Data.data(), Data.size() );
+      std::vector<uint8_t> Output;
+      for( size_t i = 0; i < Gif.Images(); ++i )
+        Gif[i].Delay( 10 );
+      Gif.ExportTo( Output );
+      Sum += Output.size();
+    } ) );
+
+    if( Sum == 0 )
+      std::cout << std::endl;
+  }
+
+  ///////////////////////
+  // GifImpl::Size() of an animation, after one of its frames changed
+  //////////////////////////////////////////////////////////////
+  void SizeAfterEdit()
+  {
+    srand( 1 );
+    GifImpl Gif( 8, 512, 512, 10 );
+    for( size_t i = 0; i < Gif.Images(); ++i )
+    {
+      vp::GifImage& Image = Gif[i];
+      U8String Pixels = Frame( 8, 512, 512 );
+      for( uint16_t y = 0; y < 512; ++y )
+        for( uint16_t x = 0; x < 512; ++x )
+          Image.SetPixel( x, y, Pixels[static_cast<size_t>(y)*512 + x] );
+    }
+
+    std::cout << "Size of 10 frames (512x512), one frame changed" << std::endl;
+    size_t Sum = 0;
+    uint8_t Color = 0;
+    Report( "written", Time( [&]() {
+      Gif[3].SetPixel( 7, 7, Color++ );
+      std::ostringstream os;
+      Gif.Write( os );
+      Sum += static_cast<size_t>( os.tellp() );
+    } ) );
+
+    Report( "counted", Time( [&]() {
+      Gif[3].SetPixel( 7, 7, Color++ );
+      Sum += Gif.Size();
+    } ) );
+
+    Report( "unchanged", Time( [&]() {
+      Sum += Gif.Size();
+    } ) );
+
+    if( Sum == 0 )
+      std::cout << std::endl;
+  }
+
+  ///////////////////////
+  struct Benchmark
+  {
+    const char* Name;
+    void (*Run)();
+  };
+
+  const Benchmark Benchmarks[] = {
+    { "eoi",    EOILessFrames },
+    { "large",  LargeFrame },
+    { "encode", EncodeLargeFrame },
+    { "dict",   Dictionary },
+    { "tiny",   EncodeTinyFrames },
+    { "blocks", SubBlocks },
+    { "import", Import },
+    { "size",   SizeAfterEdit },
+    { "rewrite",Rewrite },
+    { "export", Export },
+    { "split",  SplitFrame },
+    { "interlace", Interlace },
+    { "bulk",   BulkPixels },
+    { "rgba",   Colors },
+    { "crop",   Crop },
+    { "render", Render },
+    { "optimize", OptimizeFrames },
+    { "dedup",  RemoveDuplicates },
+    { "compare", Compare }
+  };
+}
+
+int main( int argc, char *argv[] )
+{
+  for( auto& Bench : Benchmarks )
+  {
+    bool Selected = (argc < 2);
+    for( int i = 1; i < argc; ++i )
+    {
+      if( std::strcmp( argv[i], Bench.Name ) == 0 )
+        Selected = true;
+    }
+
+    if( Selected )
+      Bench.Run();
+  }
+
+  return 0;
+}
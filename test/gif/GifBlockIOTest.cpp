@@ -113,6 +113,45 @@ void GifBlockIOTest::testWriteSubBlocksChars()
   CPPUNIT_ASSERT( static_cast<uint8_t>(str[28]) == 0x00 );
 }
 
+void GifBlockIOTest::testReadRawSubBlocks()
+{
+  // 1st block
+  strstream << static_cast<uint8_t>(0xFF);  // size 255
+  for( uint16_t i = 0; i < 255; ++i )
+    strstream << static_cast<uint8_t>(i);
+
+  // 2nd block
+  strstream << static_cast<uint8_t>(0x03);  // size 3
+  strstream << static_cast<uint8_t>(0x00);  // data, not the end
+  strstream << static_cast<uint8_t>(0xF1);
+  strstream << static_cast<uint8_t>(0xF2);
+  strstream << static_cast<uint8_t>(0x00);  // end
+  strstream << static_cast<uint8_t>(0x3B);  // not part of sub-blocks
+
+  std::string str = strstream.str();
+  CPPUNIT_ASSERT( str.size() == 262 );
+
+  // sub-blocks read as they are
+  U8String bytes;
+  GifBlockIO::ReadRawSubBlocks( strstream, bytes );
+  CPPUNIT_ASSERT( bytes.size() == 261 );
+  CPPUNIT_ASSERT( bytes == U8String(reinterpret_cast<const uint8_t*>(str.data()), 261) );
+  CPPUNIT_ASSERT( strstream.get() == 0x3B );
+
+  // empty chain
+  strstream.clear();
+  strstream.str( std::string(1, '\0') );
+  GifBlockIO::ReadRawSubBlocks( strstream, bytes );
+  CPPUNIT_ASSERT( bytes.size() == 1 && bytes[0] == 0 );
+
+  // truncated
+  strstream.clear();
+  strstream.str( str.substr(0, 200) );
+  GifBlockIO::ReadRawSubBlocks( strstream, bytes );
+  CPPUNIT_ASSERT( bytes.size() == 200 );
+  CPPUNIT_ASSERT( strstream.fail() );
+}
+
 void GifBlockIOTest::testReadBlock()
 {
   strstream << static_cast<uint8_t>(0xFF);  // size 255
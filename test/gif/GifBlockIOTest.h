@@ -35,6 +35,8 @@ class GifBlockIOTest : public CPPUNIT_NS::TestCase
   CPPUNIT_TEST( testReadSubBlocksChars );
   CPPUNIT_TEST( testWriteSubBlocksChars );
 
+  CPPUNIT_TEST( testReadRawSubBlocks );
+
   CPPUNIT_TEST( testReadBlock );
   CPPUNIT_TEST( testWriteBlock );
 
@@ -53,6 +55,8 @@ protected:
   void testReadSubBlocksChars();
   void testWriteSubBlocksChars();
 
+  void testReadRawSubBlocks();
+
   void testReadBlock();
   void testWriteBlock();
 
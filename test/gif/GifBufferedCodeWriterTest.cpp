@@ -0,0 +1,176 @@
+////////////////////////////////////////////////////////////////////////
+// Copyright (C) 2019 Xueyi Yao
+//
+// This file is part of VPixels.
+//
+// VPixels is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+// 
+// VPixels is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+// 
+// You should have received a copy of the GNU General Public License
+// along with VPixels.  If not, see <https://www.gnu.org/licenses/>.
+////////////////////////////////////////////////////////////////////////
+
+#include <cstdlib>
+#include "GifBufferedCodeWriterTest.h"
+#include "GifBufferedCodeWriter.h"
+#include "GifCodeWriter.h"
+
+CPPUNIT_TEST_SUITE_REGISTRATION( GifBufferedCodeWriterTest );
+
+// a code of all 1's for code size of 1, 2, ... 12 bits
+void GifBufferedCodeWriterTest::testCodeSize()
+{
+  for( uint8_t CodeSize = 1; CodeSize <= 12; ++CodeSize )
+  {
+    U8String Codes;
+    GifBufferedCodeWriter writeCode( Codes );
+    writeCode( static_cast<uint16_t>(0xFFFF >> (16 - CodeSize)), CodeSize );
+    writeCode.End();
+
+    if( CodeSize <= 8 )
+    {
+      CPPUNIT_ASSERT( Codes.size() == 1 );
+      CPPUNIT_ASSERT( Codes[0] == (0xFF >> (8 - CodeSize)) );
+    }
+    else
+    {
+      CPPUNIT_ASSERT( Codes.size() == 2 );
+      CPPUNIT_ASSERT( Codes[0] == 0xFF );
+      CPPUNIT_ASSERT( Codes[1] == (0xFF >> (16 - CodeSize)) );
+    }
+  }
+}
+
+// same as GifCodeWriterTest::testMixed()
+void GifBufferedCodeWriterTest::testMixed()
+{
+  U8String Codes;
+  GifBufferedCodeWriter writeCode( Codes );
+
+  // codes: 1,3,5,7,9,2,4,6,8,10,12
+  writeCode(1, 2);   // 01
+  writeCode(3, 3);   // 011
+  writeCode(5, 4);   // 0101
+  writeCode(7, 5);   // 00111
+  writeCode(9, 6);   // 001001
+  writeCode(2, 7);   // 0000010
+  writeCode(4, 8);   // 00000100
+  writeCode(6, 9);   // 000000110
+  writeCode(8, 10);  // 0000001000
+  writeCode(10, 11); // 00000001010
+  writeCode(12, 12); // 000000001100
+  writeCode.End();
+  
+  CPPUNIT_ASSERT( Codes.size() == 10 );
+  CPPUNIT_ASSERT( Codes[0] == 0xAD );  // 101,011,01
+  CPPUNIT_ASSERT( Codes[1] == 0x4E );  // 01,00111,0
+  CPPUNIT_ASSERT( Codes[2] == 0x22 );  // 0010,0010
+  CPPUNIT_ASSERT( Codes[3] == 0x20 );  // 00100,000
+  CPPUNIT_ASSERT( Codes[4] == 0x30 );  // 00110,000
+  CPPUNIT_ASSERT( Codes[5] == 0x80 );  // 1000,0000
+  CPPUNIT_ASSERT( Codes[6] == 0x80 );  // 10,000000
+  CPPUNIT_ASSERT( Codes[7] == 0x02 );  // 00000010
+  CPPUNIT_ASSERT( Codes[8] == 0x18 );  // 0001100,0
+  CPPUNIT_ASSERT( Codes[9] == 0x00 );  // 000,00000
+}
+
+// test data member m_Buffer
+void GifBufferedCodeWriterTest::testBuffer()
+{
+  U8String Codes;
+  GifBufferedCodeWriter writeCode( Codes );
+
+  // 52 bits in buffer, a 12-bit code fills it up exactly
+  for( uint8_t i = 0; i < 4; ++i )
+    writeCode( 4095, 12 );
+  writeCode( 15, 4 );
+  writeCode( 4095, 12 );
+  writeCode( 1, 1 );
+  writeCode.End();
+
+  CPPUNIT_ASSERT( Codes.size() == 9 );
+  for( uint8_t i = 0; i < 8; ++i )
+    CPPUNIT_ASSERT( Codes[i] == 0xFF );
+  CPPUNIT_ASSERT( Codes[8] == 0x01 );
+}
+
+// codes are appended to the string
+void GifBufferedCodeWriterTest::testAppend()
+{
+  U8String Codes;
+  Codes += 0xAB;
+  Codes.reserve( 1000 );
+
+  GifBufferedCodeWriter writeCode( Codes );
+  writeCode( 0x0CD, 9 );
+  writeCode.End();
+
+  CPPUNIT_ASSERT( Codes.size() == 3 );
+  CPPUNIT_ASSERT( Codes[0] == 0xAB );
+  CPPUNIT_ASSERT( Codes[1] == 0xCD );
+  CPPUNIT_ASSERT( Codes[2] == 0x00 );
+}
+
+// packed codes appended at any bit, same as writing them one by one
+void GifBufferedCodeWriterTest::testAppendBits()
+{
+  srand( 4 );
+
+  U8String Expected, Codes;
+  GifCodeWriter writeExpected( Expected );
+  GifBufferedCodeWriter writeCode( Codes );
+  for( size_t Count : { 0, 1, 5, 6, 11, 12, 100, 1000 } )
+  {
+    // a code that shifts the packed ones
+    uint8_t CodeSize = static_cast<uint8_t>(rand() % 12 + 1);
+    writeExpected( 1, CodeSize );
+    writeCode( 1, CodeSize );
+
+    U8String Packed;
+    GifBufferedCodeWriter writePacked( Packed );
+    size_t Bits = 0;
+    for( size_t i = 0; i < Count; ++i )
+    {
+      CodeSize = static_cast<uint8_t>(rand() % 12 + 1);
+      uint16_t Code = static_cast<uint16_t>(rand() & (0xFFFF >> (16 - CodeSize)));
+      writeExpected( Code, CodeSize );
+      writePacked( Code, CodeSize );
+      Bits += CodeSize;
+    }
+    writePacked.End();
+
+    writeCode.Append( Packed.data(), Bits );
+  }
+  writeExpected.End();
+  writeCode.End();
+
+  CPPUNIT_ASSERT( Codes == Expected );
+}
+
+// compare with GifCodeWriter using random codes
+void GifBufferedCodeWriterTest::testCompare()
+{
+  srand( 3 );
+
+  U8String Expected, Codes;
+  GifCodeWriter writeExpected( Expected );
+  GifBufferedCodeWriter writeCode( Codes );
+  for( uint32_t i = 0; i < 100000; ++i )
+  {
+    uint8_t CodeSize = static_cast<uint8_t>(rand() % 12 + 1);
+    uint16_t Code = static_cast<uint16_t>(rand() & (0xFFFF >> (16 - CodeSize)));
+    writeExpected( Code, CodeSize );
+    writeCode( Code, CodeSize );
+  }
+  writeExpected.End();
+  writeCode.End();
+
+  CPPUNIT_ASSERT( Codes == Expected );
+}
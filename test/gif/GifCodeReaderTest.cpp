@@ -19,6 +19,7 @@
 
 #include "GifCodeReaderTest.h"
 #include "GifCodeReader.h"
+#include "GifCodeWriter.h"
 #include "Exception.h"
 
 CPPUNIT_TEST_SUITE_REGISTRATION( GifCodeReaderTest );
@@ -243,3 +244,55 @@ void GifCodeReaderTest::testBuffer()
   CPPUNIT_ASSERT( ReadCode(12) == 1231 );   // 10011001111
   CPPUNIT_ASSERT_THROW( ReadCode(8), vp::Exception );  // 1100100, 7 bits left
 }
+
+// test reading codes without throwing at the end
+void GifCodeReaderTest::testNoThrow()
+{
+  U8String Codes;
+
+  Codes += 0xF9;  // 111,11001
+  Codes += 0x99;  // 10011001111
+  Codes += 0xC8;  // 1100100,0
+  CPPUNIT_ASSERT( Codes.size() == 3 );
+
+  GifCodeReader ReadCode( Codes );
+
+  uint16_t Code = 0;
+  CPPUNIT_ASSERT( ReadCode(5, Code) );
+  CPPUNIT_ASSERT( Code == 25 );         // 11001
+  CPPUNIT_ASSERT( ReadCode(12, Code) );
+  CPPUNIT_ASSERT( Code == 1231 );       // 10011001111
+  CPPUNIT_ASSERT( !ReadCode(8, Code) ); // 1100100, 7 bits left
+  CPPUNIT_ASSERT( !ReadCode(8, Code) );
+
+  // empty string
+  Codes.clear();
+  GifCodeReader ReadEmpty( Codes );
+  CPPUNIT_ASSERT( !ReadEmpty(1, Code) );
+}
+
+// read a long string of codes, both far from the end (8 bytes are
+// added to buffer at a time) and near the end (1 byte at a time)
+void GifCodeReaderTest::testRefill()
+{
+  U8String Codes;
+  GifCodeWriter WriteCode( Codes );
+  for( uint16_t i = 0; i < 1000; ++i )
+  {
+    uint8_t CodeSize = static_cast<uint8_t>(i % 12 + 1);
+    WriteCode( static_cast<uint16_t>((i*37) & (0xFFFF >> (16 - CodeSize))), CodeSize );
+  }
+  WriteCode.End();
+
+  GifCodeReader ReadCode( Codes );
+  for( uint16_t i = 0; i < 1000; ++i )
+  {
+    uint8_t CodeSize = static_cast<uint8_t>(i % 12 + 1);
+    CPPUNIT_ASSERT( ReadCode(CodeSize) == ((i*37) & (0xFFFF >> (16 - CodeSize))) );
+  }
+
+  // 1000 codes take 6484 bits, 4 bits are left
+  CPPUNIT_ASSERT( Codes.size() == 811 );
+  CPPUNIT_ASSERT( ReadCode(4) == 0 );
+  CPPUNIT_ASSERT_THROW( ReadCode(1), vp::Exception );
+}
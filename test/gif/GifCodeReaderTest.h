@@ -43,6 +43,8 @@ class GifCodeReaderTest : public CPPUNIT_NS::TestCase
   CPPUNIT_TEST( test12Bit );
   CPPUNIT_TEST( testMixed );
   CPPUNIT_TEST( testBuffer );
+  CPPUNIT_TEST( testNoThrow );
+  CPPUNIT_TEST( testRefill );
 
   CPPUNIT_TEST_SUITE_END();
 
@@ -62,6 +64,8 @@ protected:
   void testMixed();
   void testReader2();
   void testBuffer();
+  void testNoThrow();
+  void testRefill();
 };
 
 #endif //GifCodeReaderTest_h
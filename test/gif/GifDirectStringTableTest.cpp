@@ -0,0 +1,111 @@
+////////////////////////////////////////////////////////////////////////
+// Copyright (C) 2019 Xueyi Yao
+//
+// This file is part of VPixels.
+//
+// VPixels is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+// 
+// VPixels is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+// 
+// You should have received a copy of the GNU General Public License
+// along with VPixels.  If not, see <https://www.gnu.org/licenses/>.
+////////////////////////////////////////////////////////////////////////
+
+#include "GifDirectStringTableTest.h"
+#include "GifDirectStringTable.h"
+
+CPPUNIT_TEST_SUITE_REGISTRATION( GifDirectStringTableTest );
+
+// test Search() and Add()
+void GifDirectStringTableTest::testSearchAdd()
+{
+  GifDirectStringTable st;
+  st.Init( 8 );
+  uint32_t index1, index2;
+
+  CPPUNIT_ASSERT( st.Search( 4, 1, index1 ) == 0 );
+  st.Add( index1, 4, 1, 258 );
+  CPPUNIT_ASSERT( st.Search( 4, 1, index2 ) == 258 );
+  CPPUNIT_ASSERT( index1 == index2 );
+
+  CPPUNIT_ASSERT( st.Search( 258, 2, index1 ) == 0 );
+  st.Add( index1, 258, 2, 259 );
+  CPPUNIT_ASSERT( st.Search( 258, 2, index2 ) == 259 );
+  CPPUNIT_ASSERT( index1 == index2 );
+
+  CPPUNIT_ASSERT( st.Search( 259, 255, index1 ) == 0 );
+  st.Add( index1, 259, 255, 260 );
+  CPPUNIT_ASSERT( st.Search( 259, 255, index2 ) == 260 );
+  CPPUNIT_ASSERT( index1 == index2 );
+
+  CPPUNIT_ASSERT( st.Search( 4, 1, index1 ) == 258 );
+  CPPUNIT_ASSERT( st.Search( 4, 2, index1 ) == 0 );
+  CPPUNIT_ASSERT( st.Search( 259, 254, index1 ) == 0 );
+}
+
+// entries added before reset are no longer found
+void GifDirectStringTableTest::testReset()
+{
+  GifDirectStringTable st;
+  st.Init( 2 );
+  uint32_t index;
+
+  // fill up the table
+  uint16_t Code = 6;
+  for( uint16_t String = 0; String < 4096 && Code < 4096; ++String )
+  {
+    for( uint8_t Pixel = 0; Pixel < 4 && Code < 4096; ++Pixel )
+    {
+      CPPUNIT_ASSERT( st.Search( String, Pixel, index ) == 0 );
+      st.Add( index, String, Pixel, Code++ );
+    }
+  }
+  CPPUNIT_ASSERT( st.Search( 0, 0, index ) == 6 );
+  CPPUNIT_ASSERT( st.Search( 1022, 1, index ) == 4095 );
+
+  st.Reset();
+  CPPUNIT_ASSERT( st.Search( 0, 0, index ) == 0 );
+  CPPUNIT_ASSERT( st.Search( 1022, 1, index ) == 0 );
+
+  // the same code represents a different string + pixel
+  st.Search( 1, 3, index );
+  st.Add( index, 1, 3, 6 );
+  CPPUNIT_ASSERT( st.Search( 1, 3, index ) == 6 );
+  CPPUNIT_ASSERT( st.Search( 0, 0, index ) == 0 );
+  CPPUNIT_ASSERT( st.Search( 0, 1, index ) == 0 );
+}
+
+// change bpp
+void GifDirectStringTableTest::testInit()
+{
+  GifDirectStringTable st;
+  uint32_t index;
+
+  st.Init( 2 );
+  for( uint16_t Code = 6; Code < 300; ++Code )
+  {
+    CPPUNIT_ASSERT( st.Search( Code, 3, index ) == 0 );
+    st.Add( index, Code, 3, Code );
+  }
+  CPPUNIT_ASSERT( st.Search( 100, 3, index ) == 100 );
+
+  // codes 6, 7, ... 257 are pixels when bpp = 8
+  st.Init( 8 );
+  for( uint16_t Code = 258; Code < 300; ++Code )
+  {
+    CPPUNIT_ASSERT( st.Search( Code, 3, index ) == 0 );
+    st.Add( index, Code, 3, Code );
+  }
+  CPPUNIT_ASSERT( st.Search( 100, 3, index ) == 0 );
+  CPPUNIT_ASSERT( st.Search( 280, 3, index ) == 280 );
+
+  st.Init( 2 );
+  CPPUNIT_ASSERT( st.Search( 100, 3, index ) == 0 );
+  CPPUNIT_ASSERT( st.Search( 280, 3, index ) == 0 );
+}
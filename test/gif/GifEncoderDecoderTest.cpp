@@ -17,13 +17,67 @@
 // along with VPixels.  If not, see <https://www.gnu.org/licenses/>.
 ////////////////////////////////////////////////////////////////////////
 
+#include <algorithm>
 #include <ctime>
+#include <vector>
 #include "GifEncoderDecoderTest.h"
 #include "GifEncoder.h"
 #include "GifDecoder.h"
+#include "GifSubBlockWriter.h"
+#include "GifCodeCounter.h"
 
 CPPUNIT_TEST_SUITE_REGISTRATION( GifEncoderDecoderTest );
 
+namespace
+{
+  //////////////////////////////
+  // Follow the string table of GifEncoder over pixels of bpp 2, and
+  // return the first number of pixels, no less than From, after which
+  // the next free code is at the limit of the code size. The decoder
+  // widens its codes there, while the encoder has not yet.
+  ////////////////////////////////////////////////////////////////
+  size_t CodeSizeChange( const U8String& Pixels, const size_t From )
+  {
+    std::vector<uint16_t> Table( 4096*4, 0 );
+    uint16_t FreeCode = 6, CodeLimit = 8;
+    uint8_t  CodeSize = 3;
+    uint16_t String = Pixels[0];
+    for( size_t i = 1; i < Pixels.size(); ++i )
+    {
+      if( i >= From && FreeCode == CodeLimit && CodeSize < 12 )
+        return i;
+
+      uint16_t& Code = Table[static_cast<size_t>(String)*4 + Pixels[i]];
+      if( Code != 0 )
+      {
+        String = Code;
+        continue;
+      }
+
+      if( FreeCode <= 4095 )
+      {
+        Code = FreeCode++;
+        if( FreeCode > CodeLimit && CodeSize < 12 )
+        {
+          ++CodeSize;
+          CodeLimit = static_cast<uint16_t>(CodeLimit << 1);
+        }
+      }
+      else
+      {
+        std::fill( Table.begin(), Table.end(), 0 );
+        FreeCode = 6;
+        CodeLimit = 8;
+        CodeSize = 3;
+      }
+
+      String = Pixels[i];
+    }
+
+    return 0;
+  }
+}
+
 void GifEncoderDecoderTest::testBpp1()
 {
   srand(time(nullptr));
@@ -169,3 +223,76 @@ void GifEncoderDecoderTest::testBpp8()
   for( n = 0; n < nPixels; ++n ) 
     CPPUNIT_ASSERT( Pixels[n] == DecodedPixels[n] );
 }
+
+void GifEncoderDecoderTest::testChunks()
+{
+  for( uint8_t Bpp = 1; Bpp <= 8; ++Bpp )
+  {
+    // runs of random length, so that strings grow long
+    // as they do in real images
+    U8String Pixels;
+    size_t nPixels = 3 * GifEncoder::MinChunk + 1234;
+    while( Pixels.size() < nPixels )
+      Pixels.append( static_cast<size_t>(rand() % 16 + 1), static_cast<uint8_t>(rand() % (1 << Bpp)) );
+    Pixels.resize( nPixels );
+
+    U8String Serial, Codes, DecodedPixels;
+    GifEncoder encoder;
+    encoder( Bpp, Pixels, Serial );
+
+    // split into 3 chunks, not 4, as each one has MinChunk pixels
+    GifEncoder chunkEncoder( GifDictionary::Auto, 4 );
+    chunkEncoder( Bpp, Pixels, Codes );
+    CPPUNIT_ASSERT( Codes != Serial );
+
+    GifDecoder decoder;
+    decoder( Bpp, Codes, DecodedPixels );
+    CPPUNIT_ASSERT( DecodedPixels == Pixels );
+
+    // same codes as sub-blocks, and counted
+    U8String Chain;
+    GifSubBlockWriter WriteCode( Chain );
+    chunkEncoder( Bpp, Pixels, WriteCode );
+    GifCodeCounter CountCode;
+    chunkEncoder( Bpp, Pixels, CountCode );
+    CPPUNIT_ASSERT( Chain.size() == CountCode.Size() );
+    CPPUNIT_ASSERT( Chain.size() == Codes.size() + (Codes.size() + 254)/255 + 1 );
+
+    // the hashed table gives the same codes
+    U8String Hashed;
+    GifEncoder hashedEncoder( GifDictionary::Hashed, 4 );
+    hashedEncoder( Bpp, Pixels, Hashed );
+    CPPUNIT_ASSERT( Hashed == Codes );
+  }
+
+  // too few pixels to split
+  U8String Pixels( GifEncoder::MinChunk + 1, 0 ), Serial, Codes;
+  GifEncoder encoder;
+  encoder( 8, Pixels, Serial );
+  GifEncoder chunkEncoder( GifDictionary::Auto, 4 );
+  chunkEncoder( 8, Pixels, Codes );
+  CPPUNIT_ASSERT( Codes == Serial );
+}
+
+void GifEncoderDecoderTest::testChunkAtCodeSizeChange()
+{
+  // two chunks, the first one ending where the decoder widens its
+  // codes right after the last code of the chunk, so the clear code
+  // that follows is one bit wider than that code
+  U8String Pixels;
+  while( Pixels.size() < 3 * GifEncoder::MinChunk )
+    Pixels.append( static_cast<size_t>(rand() % 4 + 1), static_cast<uint8_t>(rand() % 4) );
+
+  size_t ChunkSize = CodeSizeChange( Pixels, GifEncoder::MinChunk );
+  CPPUNIT_ASSERT( ChunkSize >= GifEncoder::MinChunk );
+  CPPUNIT_ASSERT( ChunkSize < GifEncoder::MinChunk * 3 / 2 );
+  Pixels.resize( 2 * ChunkSize );
+
+  U8String Codes, DecodedPixels;
+  GifEncoder chunkEncoder( GifDictionary::Auto, 2 );
+  chunkEncoder( 2, Pixels, Codes );
+
+  GifDecoder decoder;
+  decoder( 2, Codes, DecodedPixels );
+  CPPUNIT_ASSERT( DecodedPixels == Pixels );
+}
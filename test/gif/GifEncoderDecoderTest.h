@@ -37,6 +37,8 @@ class GifEncoderDecoderTest : public CPPUNIT_NS::TestCase
   CPPUNIT_TEST( testBpp6 );
   CPPUNIT_TEST( testBpp7 );
   CPPUNIT_TEST( testBpp8 );
+  CPPUNIT_TEST( testChunks );
+  CPPUNIT_TEST( testChunkAtCodeSizeChange );
 
   CPPUNIT_TEST_SUITE_END();
 
@@ -49,6 +51,8 @@ protected:
   void testBpp6();
   void testBpp7();
   void testBpp8();
+  void testChunks();
+  void testChunkAtCodeSizeChange();
 };
 
 #endif //GifEncoderDecoderTest_h
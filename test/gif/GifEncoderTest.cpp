@@ -17,6 +17,7 @@
 // along with VPixels.  If not, see <https://www.gnu.org/licenses/>.
 ////////////////////////////////////////////////////////////////////////
 
+#include <cstdlib>
 #include "GifEncoderTest.h"
 #include "GifEncoder.h"
 #include "GifCodeReader.h"
@@ -1500,3 +1501,29 @@ void GifEncoderTest::testBpp8AllCodes()
     CPPUNIT_ASSERT( ReadCode(12) == i );
   CPPUNIT_ASSERT( ReadCode(12) == 257 ); // EOI code
 }
+
+// both string tables produce the same codes, an encoder object
+// can be reused for different bpp
+void GifEncoderTest::testDictionary()
+{
+  srand( 5 );
+
+  GifEncoder hashedEncoder( GifDictionary::Hashed );
+  GifEncoder directEncoder( GifDictionary::Direct );
+  GifEncoder autoEncoder;
+  for( uint8_t Bpp = 8; Bpp >= 1; --Bpp )
+  {
+    U8String Pixels;
+    while( Pixels.size() < 100000 )
+      Pixels.append( static_cast<size_t>(rand() % 8 + 1),
+                     static_cast<uint8_t>(rand() % (1 << Bpp)) );
+
+    U8String HashedCodes, DirectCodes, AutoCodes;
+    hashedEncoder( Bpp, Pixels, HashedCodes );
+    directEncoder( Bpp, Pixels, DirectCodes );
+    autoEncoder( Bpp, Pixels, AutoCodes );
+
+    CPPUNIT_ASSERT( DirectCodes == HashedCodes );
+    CPPUNIT_ASSERT( AutoCodes == HashedCodes );
+  }
+}
@@ -59,6 +59,8 @@ class GifEncoderTest : public CPPUNIT_NS::TestCase
   CPPUNIT_TEST( testBpp8MaxCode );
   CPPUNIT_TEST( testBpp8ExceedMaxCode );
 
+  CPPUNIT_TEST( testDictionary );
+
   CPPUNIT_TEST_SUITE_END();
 
 protected:
@@ -92,6 +94,8 @@ protected:
   void testBpp8MaxCode();
   void testBpp8ExceedMaxCode();
   void testBpp8AllCodes();
+
+  void testDictionary();
 };
 
 #endif //GifEncoderTest_h
@@ -0,0 +1,297 @@
+////////////////////////////////////////////////////////////////////////
+// Copyright (C) 2019 Xueyi Yao
+//
+// This file is part of VPixels.
+//
+// VPixels is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+// 
+// VPixels is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+// 
+// You should have received a copy of the GNU General Public License
+// along with VPixels.  If not, see <https://www.gnu.org/licenses/>.
+////////////////////////////////////////////////////////////////////////
+
+#include <cstdlib>
+#include "GifFastDecoderTest.h"
+#include "GifFastDecoder.h"
+#include "GifDecoder.h"
+#include "GifEncoder.h"
+#include "GifCodeWriter.h"
+#include "Exception.h"
+
+CPPUNIT_TEST_SUITE_REGISTRATION( GifFastDecoderTest );
+
+namespace
+{
+  // decode Codes using both GifDecoder and GifFastDecoder,
+  // return true if outputs are the same
+  bool Compare( const uint8_t Bpp, const U8String& Codes )
+  {
+    U8String Expected, Pixels;
+
+    GifDecoder decoder;
+    decoder( Bpp, Codes, Expected );
+
+    GifFastDecoder fastDecoder;
+    fastDecoder( Bpp, Codes, Pixels );
+
+    return Pixels == Expected;
+  }
+
+  // encode Pixels, then compare decoded outputs
+  bool Compare( const uint8_t Bpp, const U8String& Pixels, U8String& Codes )
+  {
+    Codes.clear();
+    GifEncoder encoder;
+    encoder( Bpp, Pixels, Codes );
+
+    return Compare( Bpp, Codes );
+  }
+}
+
+// Input: clear code, EOI code
+// Output: empty
+void GifFastDecoderTest::testZeroPixel()
+{
+  for( uint8_t Bpp = 1; Bpp <= 8; ++Bpp )
+  {
+    U8String Codes;
+    GifCodeWriter WriteCode( Codes );
+    WriteCode( 1 << Bpp, Bpp + 1 );        // clear code
+    WriteCode( (1 << Bpp) + 1, Bpp + 1 );  // EOI code
+    WriteCode.End();
+
+    U8String Pixels;
+    GifFastDecoder decoder;
+    decoder( Bpp, Codes, Pixels );
+    CPPUNIT_ASSERT( Pixels.size() == 0 );
+    CPPUNIT_ASSERT( Compare( Bpp, Codes ) );
+  }
+}
+
+// Input: clear code, 1, EOI code
+// Output: 1
+void GifFastDecoderTest::testOnePixel()
+{
+  for( uint8_t Bpp = 1; Bpp <= 8; ++Bpp )
+  {
+    U8String Codes;
+    GifCodeWriter WriteCode( Codes );
+    WriteCode( 1 << Bpp, Bpp + 1 );        // clear code
+    WriteCode( 1, Bpp + 1 );
+    WriteCode( (1 << Bpp) + 1, Bpp + 1 );  // EOI code
+    WriteCode.End();
+
+    U8String Pixels;
+    GifFastDecoder decoder;
+    decoder( Bpp, Codes, Pixels );
+    CPPUNIT_ASSERT( Pixels.size() == 1 );
+    CPPUNIT_ASSERT( Pixels[0] == 1 );
+    CPPUNIT_ASSERT( Compare( Bpp, Codes ) );
+  }
+}
+
+// input string does not start with clear code
+void GifFastDecoderTest::testNoClearCode()
+{
+  for( uint8_t Bpp = 1; Bpp <= 8; ++Bpp )
+  {
+    U8String Codes;
+    GifCodeWriter WriteCode( Codes );
+    WriteCode( 1, Bpp + 1 );
+    WriteCode( (1 << Bpp) + 1, Bpp + 1 );  // EOI code
+    WriteCode.End();
+
+    U8String Pixels;
+    GifFastDecoder decoder;
+    CPPUNIT_ASSERT_THROW( decoder( Bpp, Codes, Pixels ), vp::Exception );
+  }
+
+  // empty string
+  U8String Codes, Pixels;
+  GifFastDecoder decoder;
+  CPPUNIT_ASSERT_THROW( decoder( 8, Codes, Pixels ), vp::Exception );
+}
+
+// input string does not end with EOI code
+void GifFastDecoderTest::testNoEOICode()
+{
+  for( uint8_t Bpp = 1; Bpp <= 8; ++Bpp )
+  {
+    // clear code only
+    U8String Codes;
+    GifCodeWriter WriteCode( Codes );
+    WriteCode( 1 << Bpp, Bpp + 1 );
+    WriteCode.End();
+    CPPUNIT_ASSERT( Compare( Bpp, Codes ) );
+
+    // clear code, 1, 0, 1, 0
+    Codes.clear();
+    WriteCode( 1 << Bpp, Bpp + 1 );
+    WriteCode( 1, Bpp + 1 );
+    WriteCode( 0, Bpp + 1 );
+    WriteCode( 1, Bpp + 1 );
+    WriteCode( 0, Bpp + 1 );
+    WriteCode.End();
+    CPPUNIT_ASSERT( Compare( Bpp, Codes ) );
+  }
+}
+
+// code following clear code is not a pixel
+void GifFastDecoderTest::testNotPixel()
+{
+  for( uint8_t Bpp = 1; Bpp <= 8; ++Bpp )
+  {
+    U8String Codes;
+    GifCodeWriter WriteCode( Codes );
+    WriteCode( 1 << Bpp, Bpp + 1 );        // clear code
+    WriteCode( 1 << Bpp, Bpp + 1 );        // clear code
+    WriteCode( (1 << Bpp) + 2, Bpp + 1 );  // not a pixel
+    WriteCode( (1 << Bpp) + 1, Bpp + 1 );  // EOI code
+    WriteCode.End();
+
+    U8String Pixels;
+    GifFastDecoder decoder;
+    CPPUNIT_ASSERT_THROW( decoder( Bpp, Codes, Pixels ), vp::Exception );
+  }
+}
+
+// a run of the same pixel, codes are mostly not in string table
+// when they are read, i.e. string + its own 1st pixel
+void GifFastDecoderTest::testRepeatedPixel()
+{
+  U8String Pixels, Codes;
+  for( uint8_t Bpp = 1; Bpp <= 8; ++Bpp )
+  {
+    Pixels.assign( 100000, static_cast<uint8_t>((1 << Bpp) - 1) );
+    CPPUNIT_ASSERT( Compare( Bpp, Pixels, Codes ) );
+  }
+}
+
+// code exceeds the next available code, which is not produced by
+// an encoder, but treated as string + its 1st pixel, same as GifDecoder
+void GifFastDecoderTest::testCodeNotInTable()
+{
+  U8String Codes;
+  GifCodeWriter WriteCode( Codes );
+  WriteCode( 256, 9 );  // clear code
+  WriteCode( 1, 9 );
+  WriteCode( 2, 9 );
+  WriteCode( 300, 9 );  // next available code is 259
+  WriteCode( 3, 9 );
+  WriteCode( 257, 9 );  // EOI code
+  WriteCode.End();
+
+  CPPUNIT_ASSERT( Compare( 8, Codes ) );
+}
+
+// randomly generated pixels, with runs of various lengths
+void GifFastDecoderTest::testRandomPixels()
+{
+  srand( 7 );
+
+  U8String Pixels, Codes;
+  for( uint8_t Bpp = 1; Bpp <= 8; ++Bpp )
+  {
+    Pixels.clear();
+    while( Pixels.size() < 50000 )
+      Pixels.append( static_cast<size_t>(rand() % 16 + 1),
+                     static_cast<uint8_t>(rand() % (1 << Bpp)) );
+
+    CPPUNIT_ASSERT( Compare( Bpp, Pixels, Codes ) );
+  }
+}
+
+// string table is filled up, 12-bit codes, then a clear code
+// (same pixels as used by GifEncoderTest::testBpp8MaxCode()
+// and GifEncoderTest::testBpp8ExceedMaxCode())
+void GifFastDecoderTest::testBpp8MaxCode()
+{
+  U8String Pixels, Codes;
+  for( uint8_t i = 1; i <= 54; ++i )
+  {
+    for( uint8_t j = i + 1; j <= 63; ++j )
+    {
+      Pixels += i;
+      Pixels += j;
+    }
+  }
+  Pixels += 55; Pixels += 56;
+  Pixels += 55; Pixels += 57;
+  Pixels += 55;
+  CPPUNIT_ASSERT( Compare( 8, Pixels, Codes ) );
+
+  Pixels += 58; Pixels += 55;
+  for( uint8_t j = 59; j <= 63; ++j )
+  {
+    Pixels += 55;
+    Pixels += j;
+  }
+  for( uint8_t i = 56; i <= 62; ++i )
+  {
+    for( uint8_t j = i + 1; j <= 63; ++j )
+    {
+      Pixels += i;
+      Pixels += j;
+    }
+  }
+  Pixels += 1;
+  CPPUNIT_ASSERT( Compare( 8, Pixels, Codes ) );
+}
+
+// Same as GifDecoderTest::testBpp8AllCodes()
+void GifFastDecoderTest::testBpp8AllCodes()
+{
+  U8String Pixels, Codes;
+
+  // input: 256,1,258,259,...,4094,4095,257
+  GifCodeWriter WriteCode( Codes ); 
+  WriteCode( 256, 9 );  // clear code
+  WriteCode( 1, 9 );
+  uint16_t i;
+  for( i = 258; i <= 511; ++i )
+    WriteCode( i, 9 );
+  for( i = 512; i <= 1023; ++i )
+    WriteCode( i, 10 );
+  for( i = 1024; i <= 2047; ++i )
+    WriteCode( i, 11 );
+  for( i = 2048; i <= 4095; ++i )
+    WriteCode( i, 12 );
+  WriteCode( 257, 12 ); // EOI code
+  WriteCode.End();
+  CPPUNIT_ASSERT( Codes.size() == 5410 );
+
+  GifFastDecoder decoder;
+  decoder( 8, Codes, Pixels );
+
+  // output: 1,1,1,1,.... (7370880 1's)
+  CPPUNIT_ASSERT( Pixels.size() == 7370880 );
+  CPPUNIT_ASSERT( Pixels == U8String(7370880, 1) );
+}
+
+// decoded pixels are appended to output, with or without reserved space
+void GifFastDecoderTest::testAppend()
+{
+  U8String Pixels( 5000, 3 ), Codes;
+  GifEncoder encoder;
+  encoder( 2, Pixels, Codes );
+
+  GifFastDecoder decoder;
+  U8String Output;
+  decoder( 2, Codes, Output );
+  CPPUNIT_ASSERT( Output == Pixels );
+
+  decoder( 2, Codes, Output );
+  CPPUNIT_ASSERT( Output == Pixels + Pixels );
+
+  Output.clear();
+  Output.reserve( Pixels.size() );
+  decoder( 2, Codes, Output );
+  CPPUNIT_ASSERT( Output == Pixels );
+}
@@ -0,0 +1,62 @@
+////////////////////////////////////////////////////////////////////////
+// Copyright (C) 2019 Xueyi Yao
+//
+// This file is part of VPixels.
+//
+// VPixels is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+// 
+// VPixels is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+// 
+// You should have received a copy of the GNU General Public License
+// along with VPixels.  If not, see <https://www.gnu.org/licenses/>.
+////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////
+// Unit test for GifFastDecoder
+// Compare output of GifFastDecoder with that of GifDecoder.
+
+#ifndef GifFastDecoderTest_h
+#define GifFastDecoderTest_h
+
+#include <cppunit/extensions/HelperMacros.h>
+
+
+/////////////////////
+class GifFastDecoderTest : public CPPUNIT_NS::TestCase
+{
+  CPPUNIT_TEST_SUITE( GifFastDecoderTest );
+
+  CPPUNIT_TEST( testZeroPixel );
+  CPPUNIT_TEST( testOnePixel );
+  CPPUNIT_TEST( testNoClearCode );
+  CPPUNIT_TEST( testNoEOICode );
+  CPPUNIT_TEST( testNotPixel );
+  CPPUNIT_TEST( testRepeatedPixel );
+  CPPUNIT_TEST( testCodeNotInTable );
+  CPPUNIT_TEST( testRandomPixels );
+  CPPUNIT_TEST( testBpp8MaxCode );
+  CPPUNIT_TEST( testBpp8AllCodes );
+  CPPUNIT_TEST( testAppend );
+
+  CPPUNIT_TEST_SUITE_END();
+
+protected:
+  void testZeroPixel();
+  void testOnePixel();
+  void testNoClearCode();
+  void testNoEOICode();
+  void testNotPixel();
+  void testRepeatedPixel();
+  void testCodeNotInTable();
+  void testRandomPixels();
+  void testBpp8MaxCode();
+  void testBpp8AllCodes();
+  void testAppend();
+};
+
+#endif //GifFastDecoderTest_h
@@ -17,10 +17,15 @@
 // along with VPixels.  If not, see <https://www.gnu.org/licenses/>.
 ////////////////////////////////////////////////////////////////////////
 
+#include <algorithm>
 #include <iostream>
+#include <sstream>
 #include "GifImageDataTest.h"
 #include "GifImageData.h"
 #include "GifCodeWriter.h"
+#include "GifEncoder.h"
+#include "GifFastDecoder.h"
+#include "GifSubBlockReader.h"
 #include "Exception.h"
 
 CPPUNIT_TEST_SUITE_REGISTRATION( GifImageDataTest );
@@ -169,3 +174,238 @@ void GifImageDataTest::testInput()
   CPPUNIT_ASSERT( id.GetPixel(index) == 1 ); 
   CPPUNIT_ASSERT( index == 272 ); 
 }
+
+void GifImageDataTest::testEncodedSize()
+{
+  // bytes written by operator<<
+  auto Written = []( const GifImageData& id )
+  {
+    std::stringstream stream;
+    stream << id;
+    return stream.str().size();
+  };
+
+  // empty
+  GifImageData id1;
+  CPPUNIT_ASSERT( id1.EncodedSize() == Written(id1) );
+
+  // one sub-block, several sub-blocks, exactly full sub-blocks
+  for( uint32_t size : { 1u, 100u, 273u, 1000u, 4000u, 30000u } )
+  {
+    for( uint8_t bpp : { 2, 5, 8 } )
+    {
+      GifImageData id( bpp, size );
+      for( uint32_t index = 0; index < size; ++index )
+        id.SetPixel( index, static_cast<uint8_t>((index*index/7) & ((1 << bpp) - 1)) );
+
+      CPPUNIT_ASSERT( id.EncodedSize() == Written(id) );
+    }
+  }
+
+  // cached size follows changes of pixels and bpp
+  GifImageData id2( 8, 1000 );
+  size_t Size = id2.EncodedSize();
+  id2.SetPixel( 500, 0 );  // pixel not changed
+  CPPUNIT_ASSERT( id2.EncodedSize() == Size );
+
+  for( uint32_t index = 0; index < 1000; index += 3 )
+    id2.SetPixel( index, static_cast<uint8_t>(index) );
+  CPPUNIT_ASSERT( id2.EncodedSize() != Size );
+  CPPUNIT_ASSERT( id2.EncodedSize() == Written(id2) );
+
+  id2.BitsPerPixel( 2 );
+  id2.SetAllPixels( 3 );
+  CPPUNIT_ASSERT( id2.EncodedSize() == Written(id2) );
+
+  id2.BitsPerPixel( 7 );
+  CPPUNIT_ASSERT( id2.EncodedSize() == Written(id2) );
+
+  // copies carry the cached size
+  GifImageData id3( id2 );
+  CPPUNIT_ASSERT( id3.EncodedSize() == Written(id2) );
+  id3 = id1;
+  CPPUNIT_ASSERT( id3.EncodedSize() == Written(id1) );
+
+  // read from stream
+  std::stringstream stream;
+  stream << id2;
+  GifImageData id4;
+  stream >> id4;
+  CPPUNIT_ASSERT( id4.EncodedSize() == Written(id2) );
+}
+
+// image data not changed after read is written as it was read
+void GifImageDataTest::testWriteUnchanged()
+{
+  // pixels 0,1,2,3,0,1,2,3,... encoded in sub-blocks of 10 bytes,
+  // which GifEncoder never produces
+  uint8_t bpp = 2;
+  U8String Pixels;
+  for( uint32_t i = 0; i < 1000; ++i )
+    Pixels.push_back( static_cast<uint8_t>(i % 4) );
+
+  U8String Codes;
+  GifEncoder Encoder{};
+  Encoder( bpp, Pixels, Codes );
+
+  std::string Data( 1, static_cast<char>(bpp) );
+  for( size_t i = 0; i < Codes.size(); i += 10 )
+  {
+    size_t Size = std::min<size_t>( 10, Codes.size() - i );
+    Data.push_back( static_cast<char>(Size) );
+    Data.append( reinterpret_cast<const char*>(&Codes[i]), Size );
+  }
+  Data.push_back( '\0' );
+
+  // read, then written unchanged
+  std::stringstream is( Data );
+  GifImageData id;
+  is >> id;
+  CPPUNIT_ASSERT( id.Size() == 1000 );
+  CPPUNIT_ASSERT( id.GetPixel( 998 ) == 2 );
+  CPPUNIT_ASSERT( id.EncodedSize() == Data.size() );
+
+  std::stringstream os1;
+  os1 << id;
+  CPPUNIT_ASSERT( os1.str() == Data );
+
+  // still unchanged, copy and pixel set to the same color
+  GifImageData id2( id );
+  id2.SetPixel( 998, 2 );
+  std::stringstream os2;
+  os2 << id2;
+  CPPUNIT_ASSERT( os2.str() == Data );
+
+  // pixels changed, encoded again
+  id2.SetPixel( 998, 3 );
+  id2.SetPixel( 998, 2 );
+  std::stringstream os3;
+  os3 << id2;
+  CPPUNIT_ASSERT( os3.str() != Data );
+  CPPUNIT_ASSERT( id2.EncodedSize() == os3.str().size() );
+
+  std::stringstream is3( os3.str() );
+  GifImageData id3;
+  is3 >> id3;
+  for( uint32_t i = 0; i < 1000; ++i )
+    CPPUNIT_ASSERT( id3.GetPixel( i ) == Pixels[i] );
+
+  // encoded ahead of writing
+  GifImageData id5( id2 );
+  id5.SetPixel( 0, 3 );
+  std::stringstream os5;
+  os5 << id5;
+  id5.Encode();
+  CPPUNIT_ASSERT( id5.EncodedSize() == os5.str().size() );
+  std::stringstream os6;
+  os6 << id5;
+  CPPUNIT_ASSERT( os6.str() == os5.str() );
+
+  // bpp changed, encoded again
+  GifImageData id4( id );
+  id4.BitsPerPixel( 3 );
+  std::stringstream os4;
+  os4 << id4;
+  CPPUNIT_ASSERT( os4.str()[0] == 3 );
+  CPPUNIT_ASSERT( os4.str().size() == id4.EncodedSize() );
+}
+
+void GifImageDataTest::testInterlaced()
+{
+  // 3 x 11 image, each pixel is the index of its row
+  GifImageData id( 4, 33 );
+  for( uint32_t i = 0; i < 33; ++i )
+    id.SetPixel( i, static_cast<uint8_t>(i / 3) );
+  CPPUNIT_ASSERT( id.Interlaced() == 0 );
+  id.Interlaced( 3 );
+  CPPUNIT_ASSERT( id.Interlaced() == 3 );
+  CPPUNIT_ASSERT( id.GetPixel( 4 ) == 1 );
+
+  // rows are encoded in pass order
+  std::stringstream os;
+  os << id;
+  std::string Data = os.str();
+  CPPUNIT_ASSERT( Data.size() == id.EncodedSize() );
+
+  U8String Pixels;
+  GifSubBlockReader ReadCode( reinterpret_cast<const uint8_t*>(Data.data()) + 1, Data.size() - 1 );
+  GifFastDecoder Decoder{};
+  Decoder( 4, ReadCode, Pixels );
+  const uint8_t Rows[] = { 0, 8, 4, 2, 6, 10, 1, 3, 5, 7, 9 };
+  CPPUNIT_ASSERT( Pixels.size() == 33 );
+  for( uint32_t i = 0; i < 33; ++i )
+    CPPUNIT_ASSERT( Pixels[i] == Rows[i / 3] );
+
+  // and read back into place
+  std::stringstream is( Data );
+  GifImageData id2;
+  id2.Init( 33 );
+  id2.Interlaced( 3 );
+  is >> id2;
+  CPPUNIT_ASSERT( !id2.Decoded() );
+  for( uint32_t i = 0; i < 33; ++i )
+    CPPUNIT_ASSERT( id2.GetPixel( i ) == i / 3 );
+
+  // written as read, then not interlaced after the change
+  std::stringstream os2;
+  os2 << id2;
+  CPPUNIT_ASSERT( os2.str() == Data );
+
+  id2.Interlaced( 0 );
+  CPPUNIT_ASSERT( id2.GetPixel( 4 ) == 1 );
+  std::stringstream os3;
+  os3 << id2;
+  CPPUNIT_ASSERT( os3.str() != Data );
+  CPPUNIT_ASSERT( os3.str().size() == id2.EncodedSize() );
+
+  // interlacing a pending image decodes it in pass order first
+  std::stringstream is3( Data );
+  GifImageData id3;
+  id3.Init( 33 );
+  id3.Interlaced( 3 );
+  is3 >> id3;
+  id3.Interlaced( 0 );
+  CPPUNIT_ASSERT( id3.Decoded() );
+  CPPUNIT_ASSERT( id3.GetPixel( 32 ) == 10 );
+
+  // not whole rows
+  std::stringstream is4( Data );
+  GifImageData id4;
+  id4.Init( 0 );
+  id4.Interlaced( 5 );
+  is4 >> id4;
+  CPPUNIT_ASSERT_THROW( id4.Decode(), vp::Exception );
+}
+
+void GifImageDataTest::testCrop()
+{
+  // 7 x 5, pixel = 10*y + x
+  GifImageData id( 7, 35 );
+  for( uint32_t i = 0; i < 35; ++i )
+    id.SetPixel( i, static_cast<uint8_t>(10*(i / 7) + i % 7) );
+  id.Interlaced( 7 );
+  const uint8_t* pData = id.Data();
+
+  // 4 x 3 at (2, 1), in place
+  id.Crop( 7, 2, 1, 4, 3 );
+  CPPUNIT_ASSERT( id.Size() == 12 );
+  CPPUNIT_ASSERT( id.Data() == pData );
+  CPPUNIT_ASSERT( id.Interlaced() == 4 );
+  for( uint32_t i = 0; i < 12; ++i )
+    CPPUNIT_ASSERT( id.GetPixel( i ) == 10*(i / 4 + 1) + i % 4 + 2 );
+
+  // whole rows
+  id.Crop( 4, 0, 1, 4, 2 );
+  CPPUNIT_ASSERT( id.Size() == 8 );
+  CPPUNIT_ASSERT( id.GetPixel( 0 ) == 22 );
+  CPPUNIT_ASSERT( id.GetPixel( 7 ) == 35 );
+
+  // encoded again
+  std::stringstream os;
+  os << id;
+  CPPUNIT_ASSERT( os.str().size() == id.EncodedSize() );
+
+  // out of range
+  CPPUNIT_ASSERT_THROW( id.Crop( 4, 1, 0, 4, 1 ), vp::Exception );
+  CPPUNIT_ASSERT_THROW( id.Crop( 4, 0, 1, 4, 2 ), vp::Exception );
+}
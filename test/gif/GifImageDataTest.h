@@ -31,12 +31,20 @@ class GifImageDataTest : public CPPUNIT_NS::TestCase
   CPPUNIT_TEST( testCtors );
   CPPUNIT_TEST( testOutput );
   CPPUNIT_TEST( testInput );
+  CPPUNIT_TEST( testEncodedSize );
+  CPPUNIT_TEST( testWriteUnchanged );
+  CPPUNIT_TEST( testInterlaced );
+  CPPUNIT_TEST( testCrop );
   CPPUNIT_TEST_SUITE_END();
 
 protected:
   void testCtors();
   void testOutput();
   void testInput();
+  void testEncodedSize();
+  void testWriteUnchanged();
+  void testInterlaced();
+  void testCrop();
 };
 
 #endif //GifImageDataTest_h
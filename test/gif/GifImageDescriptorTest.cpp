@@ -17,6 +17,8 @@
 // along with VPixels.  If not, see <https://www.gnu.org/licenses/>.
 ////////////////////////////////////////////////////////////////////////
 
+#include <algorithm>
+#include <sstream>
 #include "GifImageDescriptorTest.h"
 #include "GifImageDescriptor.h"
 #include "Exception.h"
@@ -495,3 +497,99 @@ void GifImageDescriptorTest::testInput()
     for( uint8_t y = 0; y <= 1; ++y )
       CPPUNIT_ASSERT( id2.GetPixel( x, y ) == 5 );
 }
+
+void GifImageDescriptorTest::testInterlaced()
+{
+  GifImageDescriptor id1( 4, 5, 13, 1, 2, true );
+  for( uint16_t x = 0; x < 5; ++x )
+    for( uint16_t y = 0; y < 13; ++y )
+      id1.SetPixel( x, y, static_cast<uint8_t>(y) );
+
+  id1.Interlaced( true );
+  CPPUNIT_ASSERT( id1.Interlaced() );
+  CPPUNIT_ASSERT( id1.LocalColorTable() );
+  CPPUNIT_ASSERT( id1.GetPixel( 4, 12 ) == 12 );
+
+  std::stringstream stream1;
+  id1.Write( stream1 );
+  std::string str = stream1.str();
+  CPPUNIT_ASSERT( static_cast<uint8_t>(str[9]) == 0xC3 ); // packed byte
+  CPPUNIT_ASSERT( str.size() == id1.Size() );
+
+  // read, no longer rejected
+  GifImageDescriptor id2;
+  CPPUNIT_ASSERT( stream1.get() == 0x2C );  // ID
+  id2.Read( stream1 );
+  CPPUNIT_ASSERT( id2.Interlaced() );
+  CPPUNIT_ASSERT( id2.ColorTableSize() == 16 );
+  for( uint16_t x = 0; x < 5; ++x )
+    for( uint16_t y = 0; y < 13; ++y )
+      CPPUNIT_ASSERT( id2.GetPixel( x, y ) == y );
+
+  // still interlaced after crop
+  id2.Crop( 2, 4, 3, 9 );
+  CPPUNIT_ASSERT( id2.Interlaced() );
+  std::stringstream stream2;
+  id2.Write( stream2 );
+  GifImageDescriptor id3;
+  CPPUNIT_ASSERT( stream2.get() == 0x2C );  // ID
+  id3.Read( stream2 );
+  CPPUNIT_ASSERT( id3.Width() == 3 );
+  CPPUNIT_ASSERT( id3.Height() == 9 );
+  for( uint16_t x = 0; x < 3; ++x )
+    for( uint16_t y = 0; y < 9; ++y )
+      CPPUNIT_ASSERT( id3.GetPixel( x, y ) == y + 2 );
+
+  // turned off
+  id3.Interlaced( false );
+  CPPUNIT_ASSERT( !id3.Interlaced() );
+  std::stringstream stream3;
+  id3.Write( stream3 );
+  CPPUNIT_ASSERT( static_cast<uint8_t>(stream3.str()[9]) == 0x83 );
+  CPPUNIT_ASSERT( id3.GetPixel( 2, 8 ) == 10 );
+}
+
+void GifImageDescriptorTest::testRect()
+{
+  GifImageDescriptor id1( 8, 6, 5, 3, 4 );
+  uint8_t Rect[] = { 1, 2, 3,
+                     4, 5, 6 };
+  id1.SetRect( 2, 1, 3, 2, Rect );
+  CPPUNIT_ASSERT( id1.GetPixel( 1, 1 ) == 0 );
+  CPPUNIT_ASSERT( id1.GetPixel( 2, 1 ) == 1 );
+  CPPUNIT_ASSERT( id1.GetPixel( 4, 1 ) == 3 );
+  CPPUNIT_ASSERT( id1.GetPixel( 5, 1 ) == 0 );
+  CPPUNIT_ASSERT( id1.GetPixel( 2, 2 ) == 4 );
+  CPPUNIT_ASSERT( id1.GetPixel( 4, 2 ) == 6 );
+  CPPUNIT_ASSERT( id1.GetPixel( 4, 3 ) == 0 );
+
+  uint8_t Out[12] = {};
+  id1.GetRect( 1, 1, 4, 3, Out );
+  const uint8_t Expected[] = { 0, 1, 2, 3,
+                               0, 4, 5, 6,
+                               0, 0, 0, 0 };
+  CPPUNIT_ASSERT( std::equal( Out, Out + 12, Expected ) );
+
+  // whole rows
+  uint8_t Rows[12];
+  for( uint8_t i = 0; i < 12; ++i )
+    Rows[i] = static_cast<uint8_t>(i + 10);
+  id1.SetRect( 0, 3, 6, 2, Rows );
+  CPPUNIT_ASSERT( id1.GetPixel( 0, 3 ) == 10 );
+  CPPUNIT_ASSERT( id1.GetPixel( 5, 4 ) == 21 );
+  id1.GetRect( 0, 3, 6, 2, Out );
+  CPPUNIT_ASSERT( std::equal( Out, Out + 12, Rows ) );
+
+  const uint8_t* pData = id1.Data();
+  CPPUNIT_ASSERT( pData[6 + 2] == 1 );
+  CPPUNIT_ASSERT( pData[6*4 + 5] == 21 );
+
+  // empty rectangle
+  id1.SetRect( 6, 5, 0, 0, Rect );
+  id1.GetRect( 6, 5, 0, 0, Out );
+
+  // out of range
+  CPPUNIT_ASSERT_THROW( id1.SetRect( 4, 0, 3, 1, Rect ), vp::Exception );
+  CPPUNIT_ASSERT_THROW( id1.GetRect( 0, 4, 1, 2, Out ), vp::Exception );
+  CPPUNIT_ASSERT_THROW( id1.GetRect( 0, 5, 1, 1, Out ), vp::Exception );
+}
@@ -34,6 +34,8 @@ class GifImageDescriptorTest : public CPPUNIT_NS::TestCase
   CPPUNIT_TEST( testCrop );
   CPPUNIT_TEST( testOutput );
   CPPUNIT_TEST( testInput );
+  CPPUNIT_TEST( testInterlaced );
+  CPPUNIT_TEST( testRect );
   CPPUNIT_TEST_SUITE_END();
 
 protected:
@@ -43,6 +45,8 @@ protected:
   void testCrop();
   void testOutput();
   void testInput();
+  void testInterlaced();
+  void testRect();
 };
 
 #endif //GifImageDescriptorTest_h
@@ -229,6 +229,163 @@ void GifImageTest::testCompare()
   CPPUNIT_ASSERT( gif1[7] != gif1[5] );
 }
 
+void GifImageTest::testComparePalettes()
+{
+  // 100 x 50 pixels, so the last block of 64 pixels is a partial one
+  vp::Gif gif( 2, 100, 50, 12 );
+  for( uint8_t i = 0; i < 4; ++i )
+    gif.SetColorTable( i, i, i, i );
+
+  // the same color table, one pixel different in the last block
+  gif[1].SetPixel( 99, 49, 1 );
+  CPPUNIT_ASSERT( gif[0] != gif[1] );
+  CPPUNIT_ASSERT( gif[1] != gif[0] );
+  gif[1].SetPixel( 99, 49, 0 );
+  CPPUNIT_ASSERT( gif[0] == gif[1] );
+
+  // the same indices, one of them transparent
+  gif[2].TransColor( 2 );
+  gif[3].SetPixel( 50, 25, 2 );
+  gif[2].SetPixel( 50, 25, 2 );
+  CPPUNIT_ASSERT( gif[2] != gif[3] );
+  CPPUNIT_ASSERT( gif[3] != gif[2] );
+  // transparent, but different indices
+  gif[3].TransColor( 3 );
+  gif[3].SetPixel( 50, 25, 3 );
+  CPPUNIT_ASSERT( gif[2] == gif[3] );
+  CPPUNIT_ASSERT( gif[3] == gif[2] );
+  // different transparent colors, not shown
+  gif[4].TransColor( 1 );
+  CPPUNIT_ASSERT( gif[0] == gif[4] );
+  CPPUNIT_ASSERT( gif[4] == gif[0] );
+  gif[4].SetPixel( 0, 0, 1 );
+  CPPUNIT_ASSERT( gif[0] != gif[4] );
+
+  // different indices of the same color
+  gif[5].ColorTableSize( 4 );
+  gif[5].SetColorTable( 0, 0, 0, 0 );
+  gif[5].SetColorTable( 1, 0, 0, 0 );
+  gif[5].SetColorTable( 2, 2, 2, 2 );
+  gif[5].SetColorTable( 3, 3, 3, 3 );
+  gif[6].ColorTableSize( 4 );
+  for( uint8_t i = 0; i < 4; ++i )
+  {
+    uint8_t R, G, B;
+    gif[5].GetColorTable( i, R, G, B );
+    gif[6].SetColorTable( i, R, G, B );
+  }
+  gif[6].SetAllPixels( 1 );
+  CPPUNIT_ASSERT( gif[5] == gif[6] );
+  CPPUNIT_ASSERT( gif[6] == gif[0] );
+  gif[6].SetPixel( 10, 10, 2 );
+  CPPUNIT_ASSERT( gif[5] != gif[6] );
+
+  // a local color table different at one entry, not shown
+  gif[7].ColorTableSize( 4 );
+  for( uint8_t i = 0; i < 4; ++i )
+    gif[7].SetColorTable( i, i, i, i );
+  gif[7].SetColorTable( 3, 9, 9, 9 );
+  CPPUNIT_ASSERT( gif[0] == gif[7] );
+  gif[7].SetPixel( 99, 0, 3 );
+  gif[8].SetPixel( 99, 0, 3 );
+  CPPUNIT_ASSERT( gif[7] != gif[8] );
+
+  // a local color table in reverse order, and the indices reversed
+  gif[9].ColorTableSize( 4 );
+  for( uint8_t i = 0; i < 4; ++i )
+    gif[9].SetColorTable( i, 3 - i, 3 - i, 3 - i );
+  gif[9].SetAllPixels( 3 );
+  CPPUNIT_ASSERT( gif[0] == gif[9] );
+  CPPUNIT_ASSERT( gif[9] == gif[0] );
+  gif[9].SetPixel( 99, 49, 2 );
+  gif[10].SetPixel( 99, 49, 1 );
+  CPPUNIT_ASSERT( gif[9] == gif[10] );
+  gif[10].SetPixel( 99, 49, 2 );
+  CPPUNIT_ASSERT( gif[9] != gif[10] );
+}
+
+void GifImageTest::testHash()
+{
+  vp::Gif gif1( 2, 10, 20, 12 );
+  for( uint8_t i = 0; i < 4; ++i )
+    gif1.SetColorTable( i, i, i, i );
+
+  // different origin
+  gif1[0].Crop( 0, 2, 5, 10 );
+  gif1[1].Crop( 2, 0, 5, 10 );
+  // different dimension
+  gif1[2].Crop( 2, 2, 5, 8 );
+  gif1[3].Crop( 2, 2, 8, 5 );
+  // one pixel different
+  gif1[4].SetPixel( 4, 9, 2 );
+  gif1[5].SetPixel( 4, 9, 3 );
+  // transparent pixel
+  gif1[6].TransColor( 2 );
+  gif1[6].SetPixel( 4, 9, 2 );
+  gif1[7].TransColor( 3 );
+  gif1[7].SetPixel( 4, 9, 3 );
+  // local color table, the same colors as the global one
+  gif1[8].ColorTableSize( 4 );
+  for( uint8_t i = 0; i < 4; ++i )
+    gif1[8].SetColorTable( i, i, i, i );
+  // local color table in reverse order, and the indices reversed
+  gif1[9].ColorTableSize( 4 );
+  for( uint8_t i = 0; i < 4; ++i )
+    gif1[9].SetColorTable( i, 3 - i, 3 - i, 3 - i );
+  gif1[9].SetAllPixels( 3 );
+
+  vp::Gif gif2 = gif1;
+
+  // images equal by operator== have equal hashes
+  CPPUNIT_ASSERT( gif1[6] == gif1[7] );
+  CPPUNIT_ASSERT( gif1[6].Hash() == gif1[7].Hash() );
+  CPPUNIT_ASSERT( gif1[8] == gif1[10] );
+  CPPUNIT_ASSERT( gif1[8].Hash() == gif1[10].Hash() );
+  CPPUNIT_ASSERT( gif1[9] == gif1[10] );
+  CPPUNIT_ASSERT( gif1[9].Hash() == gif1[10].Hash() );
+  for( size_t i = 0; i < 12; ++i )
+    CPPUNIT_ASSERT( gif1[i].Hash() == gif2[i].Hash() );
+
+  // different origin, dimension, pixel, or transparent pixel
+  CPPUNIT_ASSERT( gif1[0].Hash() != gif1[1].Hash() );
+  CPPUNIT_ASSERT( gif1[2].Hash() != gif1[3].Hash() );
+  CPPUNIT_ASSERT( gif1[4].Hash() != gif1[5].Hash() );
+  CPPUNIT_ASSERT( gif1[4].Hash() != gif1[10].Hash() );
+  CPPUNIT_ASSERT( gif1[4].Hash() != gif1[6].Hash() );
+  CPPUNIT_ASSERT( gif1[5].Hash() != gif1[7].Hash() );
+
+  // kept until pixels change
+  uint64_t Hash = gif1[10].Hash();
+  gif1[10].SetPixel( 4, 9, 2 );
+  CPPUNIT_ASSERT( gif1[10].Hash() != Hash );
+  CPPUNIT_ASSERT( gif1[10].Hash() == gif1[4].Hash() );
+  gif1[10].SetPixel( 4, 9, 0 );
+  CPPUNIT_ASSERT( gif1[10].Hash() == Hash );
+  uint8_t Row[20] = {};
+  Row[4] = 3;
+  gif1[10].SetRow( 9, Row );
+  CPPUNIT_ASSERT( gif1[10].Hash() == gif1[5].Hash() );
+  gif1[10].SetAllPixels( 0 );
+  CPPUNIT_ASSERT( gif1[10].Hash() == Hash );
+
+  // or the color table changes
+  gif1.SetColorTable( 0, 9, 9, 9 );
+  CPPUNIT_ASSERT( gif1[10].Hash() != Hash );
+  CPPUNIT_ASSERT( gif1[11].Hash() == gif1[10].Hash() );
+  CPPUNIT_ASSERT( gif1[8].Hash() == Hash );  // local color table
+  gif1.SetColorTable( 0, 0, 0, 0 );
+  CPPUNIT_ASSERT( gif1[10].Hash() == Hash );
+
+  // or the transparent color changes
+  gif1[10].TransColor( 0 );
+  CPPUNIT_ASSERT( gif1[10].Hash() != Hash );
+  gif1[11].TransColor( 1 );
+  gif1[11].SetAllPixels( 1 );
+  CPPUNIT_ASSERT( gif1[11].Hash() == gif1[10].Hash() );
+  gif1[10].HasTransColor( false );
+  CPPUNIT_ASSERT( gif1[10].Hash() == Hash );
+}
+
 void GifImageTest::testGetPixel()
 {
   vp::Gif gif( 2, 5, 5, 2 );
@@ -31,6 +31,8 @@ class GifImageTest : public CPPUNIT_NS::TestCase
   CPPUNIT_TEST( testTwoComponents );
   CPPUNIT_TEST( testAssignment );
   CPPUNIT_TEST( testCompare );
+  CPPUNIT_TEST( testComparePalettes );
+  CPPUNIT_TEST( testHash );
   CPPUNIT_TEST( testGetPixel );
   CPPUNIT_TEST( testTransparent );
   CPPUNIT_TEST( testSetPixel );
@@ -43,6 +45,8 @@ protected:
   void testTwoComponents();
   void testAssignment();
   void testCompare();
+  void testComparePalettes();
+  void testHash();
   void testGetPixel();
   void testTransparent();
   void testSetPixel();
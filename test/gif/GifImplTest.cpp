@@ -17,6 +17,10 @@
 // along with VPixels.  If not, see <https://www.gnu.org/licenses/>.
 ////////////////////////////////////////////////////////////////////////
 
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <sstream>
 #include "GifImplTest.h"
 #include "GifImpl.h"
 #include "GifImage.h"
@@ -447,3 +451,96 @@ void GifImplTest::testWriteTwoImages()
   // Gif Trailer
   CPPUNIT_ASSERT( static_cast<uint8_t>(str[106+size+2]) == GifImpl::m_GifTrailer );
 }
+
+// Import() parses the mapped file, compare it with reading from stream
+void GifImplTest::testImport()
+{
+  srand( 7 );
+  GifImpl gifimpl( 8, 300, 200, 3 );
+  for( size_t i = 0; i < gifimpl.Images(); ++i )
+  {
+    vp::GifImage& image = gifimpl[i];
+    image.Delay( static_cast<uint16_t>(10*i) );
+    for( uint16_t y = 0; y < image.Height(); ++y )
+      for( uint16_t x = 0; x < image.Width(); ++x )
+        image.SetPixel( x, y, static_cast<uint8_t>(rand() % 16 + (x/10)*4) );
+  }
+  CPPUNIT_ASSERT( gifimpl.Export( "export_mapped.gif", true ) );
+
+  GifImpl mapped;
+  CPPUNIT_ASSERT( mapped.Import( "export_mapped.gif" ) );
+
+  GifImpl streamed;
+  std::ifstream File( "export_mapped.gif", std::ios::binary );
+  CPPUNIT_ASSERT( streamed.Read( File ) == GifImpl::m_GifTrailer );
+  streamed.m_ImageVec = GifImageVecBuilder()( streamed, streamed.m_ComponentVec );
+  File.close();
+  std::remove( "export_mapped.gif" );
+
+  CPPUNIT_ASSERT( mapped.Images() == 3 );
+  CPPUNIT_ASSERT( streamed.Images() == 3 );
+  CPPUNIT_ASSERT( mapped.Size() == streamed.Size() );
+  for( size_t i = 0; i < gifimpl.Images(); ++i )
+  {
+    CPPUNIT_ASSERT( mapped[i].Delay() == 10*i );
+    CPPUNIT_ASSERT( mapped[i] == gifimpl[i] );
+    CPPUNIT_ASSERT( streamed[i] == gifimpl[i] );
+  }
+}
+
+void GifImplTest::testSize()
+{
+  // bytes written by Write()
+  auto Written = []( GifImpl& gifimpl )
+  {
+    std::ostringstream os;
+    gifimpl.Write( os );
+    return static_cast<size_t>( os.tellp() );
+  };
+
+  // single image
+  GifImpl gifimpl1( 3, 30, 20, 1 );
+  CPPUNIT_ASSERT( gifimpl1.Size() == Written(gifimpl1) );
+
+  // multiple images, local color table
+  GifImpl gifimpl2( 5, 40, 30, 3, false );
+  CPPUNIT_ASSERT( gifimpl2.Size() == Written(gifimpl2) );
+
+  // pixels changed
+  for( uint16_t y = 0; y < 30; ++y )
+    for( uint16_t x = 0; x < 40; ++x )
+      gifimpl2[1].SetPixel( x, y, static_cast<uint8_t>((x*y) % 32) );
+  size_t Size = gifimpl2.Size();
+  CPPUNIT_ASSERT( Size == Written(gifimpl2) );
+  CPPUNIT_ASSERT( gifimpl2.Size() == Size );
+
+  // bpp changed
+  gifimpl2[1].BitsPerPixel( 7 );
+  CPPUNIT_ASSERT( gifimpl2.Size() == Written(gifimpl2) );
+
+  // color table changed
+  gifimpl2[2].ColorTableSize( 64 );
+  CPPUNIT_ASSERT( gifimpl2.Size() == Written(gifimpl2) );
+  gifimpl2[2].ColorTableSize( 0 );
+  CPPUNIT_ASSERT( gifimpl2.Size() == Written(gifimpl2) );
+
+  // cropped
+  gifimpl2[1].Crop( 5, 5, 20, 10 );
+  CPPUNIT_ASSERT( gifimpl2.Size() == Written(gifimpl2) );
+
+  // removed
+  gifimpl2.Remove( 0 );
+  CPPUNIT_ASSERT( gifimpl2.Size() == Written(gifimpl2) );
+
+  // copied
+  GifImpl gifimpl3( gifimpl2 );
+  CPPUNIT_ASSERT( gifimpl3.Size() == Written(gifimpl2) );
+
+  // imported
+  std::ostringstream os;
+  gifimpl2.Write( os );
+  std::string Data = os.str();
+  GifImpl gifimpl4;
+  gifimpl4.Import( reinterpret_cast<const uint8_t*>(Data.data()), Data.size() );
+  CPPUNIT_ASSERT( gifimpl4.Size() == Data.size() );
+}
@@ -35,6 +35,9 @@ class GifImplTest : public CPPUNIT_NS::TestCase
   CPPUNIT_TEST( testWriteOneImage );
   CPPUNIT_TEST( testWriteTwoImages );
 
+  CPPUNIT_TEST( testImport );
+  CPPUNIT_TEST( testSize );
+
   CPPUNIT_TEST_SUITE_END();
 
 protected:
@@ -43,5 +46,7 @@ protected:
   void testReadTwoImages();
   void testWriteOneImage();
   void testWriteTwoImages();
+  void testImport();
+  void testSize();
 };
 #endif //GifImplTest_h
@@ -0,0 +1,321 @@
+////////////////////////////////////////////////////////////////////////
+// Copyright (C) 2019 Xueyi Yao
+//
+// This file is part of VPixels.
+//
+// VPixels is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+// 
+// VPixels is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+// 
+// You should have received a copy of the GNU General Public License
+// along with VPixels.  If not, see <https://www.gnu.org/licenses/>.
+////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////
+
+#include <utility>
+#include <vector>
+#include "GifPassManagerTest.h"
+#include "GifPassManager.h"
+#include "GifRenderer.h"
+#include "Gif.h"
+#include "GifImage.h"
+#include "Exception.h"
+
+CPPUNIT_TEST_SUITE_REGISTRATION( GifPassManagerTest );
+
+using Pass = vp::GifPassManager::Pass;
+
+namespace
+{
+  // frames rendered and how long each shows, consecutive frames
+  // that are the same taken as one
+  std::vector<std::pair<std::vector<uint8_t>, size_t>> Timeline( const vp::Gif& gif )
+  {
+    std::vector<std::pair<std::vector<uint8_t>, size_t>> Frames;
+    vp::GifRenderer renderer( gif );
+    size_t Size = 4*static_cast<size_t>(gif.Width())*gif.Height();
+    for( size_t i = 0; i < gif.Images(); ++i )
+    {
+      const uint8_t* p = renderer.Render( i );
+      std::vector<uint8_t> Frame( p, p + Size );
+      if( !Frames.empty() && Frames.back().first == Frame )
+        Frames.back().second += gif[i].Delay();
+      else
+        Frames.emplace_back( std::move(Frame), gif[i].Delay() );
+    }
+
+    return Frames;
+  }
+
+  // run a single pass
+  bool Run( const Pass Each, vp::Gif& gif )
+  {
+    vp::GifPassManager manager;
+    manager.Add( Each );
+    return manager.Run( gif ).front().Changed;
+  }
+
+  // an animation of Images, pixel (x, y) of image i is Index(i, x, y)
+  template<typename F>
+  vp::Gif MakeGif( const uint16_t Width, const uint16_t Height, const size_t Images, F Index )
+  {
+    vp::Gif gif( 4, Width, Height, Images );
+    for( uint16_t c = 0; c < 16; ++c )
+      gif.SetColorTable( static_cast<uint8_t>(c), static_cast<uint8_t>(c*16), static_cast<uint8_t>(c), 0 );
+
+    for( size_t i = 0; i < Images; ++i )
+    {
+      gif[i].Delay( 10 );
+      for( uint16_t y = 0; y < Height; ++y )
+        for( uint16_t x = 0; x < Width; ++x )
+          gif[i].SetPixel( x, y, Index( i, x, y ) );
+    }
+
+    return gif;
+  }
+}
+
+void GifPassManagerTest::testPasses()
+{
+  vp::GifPassManager manager;
+  CPPUNIT_ASSERT( manager.Passes() == 0 );
+
+  manager.Add( Pass::ReduceBpp );
+  manager.Add( "Nothing", []( vp::Gif& ) { return false; } );
+  CPPUNIT_ASSERT( manager.Passes() == 2 );
+  CPPUNIT_ASSERT( manager.Name( 0 ) == "ReduceBpp" );
+  CPPUNIT_ASSERT( manager.Name( 1 ) == "Nothing" );
+  CPPUNIT_ASSERT_THROW( manager.Name( 2 ), vp::Exception );
+  CPPUNIT_ASSERT_THROW( manager.Add( "None", nullptr ), vp::Exception );
+
+  vp::GifPassManager downsize = vp::GifPassManager::Downsize();
+  CPPUNIT_ASSERT( downsize.Passes() == 7 );
+  CPPUNIT_ASSERT( downsize.Name( 0 ) == vp::GifPassManager::Name( Pass::RemoveDuplicates ) );
+  CPPUNIT_ASSERT( downsize.Name( 6 ) == vp::GifPassManager::Name( Pass::ReduceBpp ) );
+}
+
+void GifPassManagerTest::testRun()
+{
+  vp::Gif gif = MakeGif( 8, 8, 2, []( size_t, uint16_t x, uint16_t ) {
+    return static_cast<uint8_t>(x % 2); } );
+
+  size_t Calls = 0;
+  vp::GifPassManager manager;
+  manager.Add( "Count", [&]( vp::Gif& ) { ++Calls; return false; } );
+  manager.Add( "Crop", [&]( vp::Gif& g ) { g.CropAll( 0, 0, 4, 4 ); return true; } );
+  manager.Add( Pass::ReduceBpp );
+
+  // not measured
+  auto Results = manager.Run( gif );
+  CPPUNIT_ASSERT( Calls == 1 );
+  CPPUNIT_ASSERT( Results.size() == 3 );
+  CPPUNIT_ASSERT( Results[0].Name == "Count" && !Results[0].Changed );
+  CPPUNIT_ASSERT( Results[1].Name == "Crop" && Results[1].Changed );
+  CPPUNIT_ASSERT( Results[2].Name == "ReduceBpp" && Results[2].Changed );
+  CPPUNIT_ASSERT( Results[2].SizeBefore == 0 && Results[2].SizeAfter == 0 );
+  CPPUNIT_ASSERT( gif.Width() == 4 && gif[0].BitsPerPixel() == 2 );
+
+  // measured
+  Results = manager.Run( gif, true );
+  CPPUNIT_ASSERT( Calls == 2 );
+  CPPUNIT_ASSERT( Results[0].SizeBefore == Results[0].SizeAfter );
+  CPPUNIT_ASSERT( Results[1].SizeBefore == Results[0].SizeAfter );
+  CPPUNIT_ASSERT( Results[2].SizeAfter == gif.Size() );
+  CPPUNIT_ASSERT( !Results[2].Changed );
+}
+
+void GifPassManagerTest::testRemove1PixelImages()
+{
+  vp::Gif gif = MakeGif( 6, 4, 5, []( size_t i, uint16_t x, uint16_t y ) {
+    return static_cast<uint8_t>((i + x + y) % 4); } );
+
+  // 1: transparent, 3: not transparent, 4: transparent, after one restored
+  gif[1].Crop( 2, 2, 1, 1 );
+  gif[1].TransColor( gif[1].GetPixel( 0, 0 ) );
+  gif[3].Crop( 0, 0, 1, 1 );
+  gif[3].DisposalMethod( 2 );
+  gif[4].Crop( 5, 3, 1, 1 );
+  gif[4].TransColor( gif[4].GetPixel( 0, 0 ) );
+
+  auto Frames = Timeline( gif );
+  CPPUNIT_ASSERT( Run( Pass::Remove1PixelImages, gif ) );
+  CPPUNIT_ASSERT( gif.Images() == 4 );
+  CPPUNIT_ASSERT( gif[0].Delay() == 20 );
+  CPPUNIT_ASSERT( gif[2].Width() == 1 && gif[3].Width() == 1 );
+  CPPUNIT_ASSERT( Timeline( gif ) == Frames );
+  CPPUNIT_ASSERT( !Run( Pass::Remove1PixelImages, gif ) );
+}
+
+void GifPassManagerTest::testRemoveDuplicates()
+{
+  // 0 = 1 = 2 restored to previous, 3 = 4 = 5, 4 restored to background
+  vp::Gif gif = MakeGif( 6, 4, 6, []( size_t i, uint16_t x, uint16_t y ) {
+    return static_cast<uint8_t>(((i < 3)? 1 : 2) + (x*y) % 3); } );
+  gif[1].DisposalMethod( 3 );
+  gif[2].DisposalMethod( 3 );
+  for( size_t i : { 3, 4, 5 } )
+  {
+    gif[i].Crop( 1, 1, 3, 2 );
+    gif[i].TransColor( 2 );
+  }
+  gif[4].DisposalMethod( 2 );
+
+  auto Frames = Timeline( gif );
+  CPPUNIT_ASSERT( Run( Pass::RemoveDuplicates, gif ) );
+  CPPUNIT_ASSERT( gif.Images() == 3 );
+  CPPUNIT_ASSERT( gif[0].Delay() == 30 && gif[0].DisposalMethod() == 1 );
+  CPPUNIT_ASSERT( gif[1].Delay() == 20 && gif[1].DisposalMethod() == 2 );
+  CPPUNIT_ASSERT( gif[2].Delay() == 10 );
+  CPPUNIT_ASSERT( Timeline( gif ) == Frames );
+
+  // 2 equal images merge into a single image
+  vp::Gif gif1 = MakeGif( 4, 4, 2, []( size_t, uint16_t x, uint16_t y ) {
+    return static_cast<uint8_t>(x + y); } );
+  gif1[1].DisposalMethod( 2 );
+  vp::Gif gif2( gif1 );
+  CPPUNIT_ASSERT( Run( Pass::RemoveDuplicates, gif1 ) );
+  CPPUNIT_ASSERT( gif1.Images() == 1 );
+  CPPUNIT_ASSERT( gif1[0].DisposalMethod() == 0 );
+  CPPUNIT_ASSERT( gif1[0] == gif2[0] );
+
+  // unless they have a transparent color
+  gif2[0].TransColor( 3 );
+  gif2[1].TransColor( 3 );
+  CPPUNIT_ASSERT( !Run( Pass::RemoveDuplicates, gif2 ) );
+  CPPUNIT_ASSERT( gif2.Images() == 2 );
+}
+
+void GifPassManagerTest::testSingleColorTable()
+{
+  // 2 images of local color tables, sharing 2 of 4 colors
+  vp::Gif gif( 4, 4, 4, 2, false );
+  for( size_t i = 0; i < 2; ++i )
+  {
+    gif[i].ColorTableSize( 16 );
+    for( uint16_t c = 0; c < 16; ++c )
+      gif[i].SetColorTable( static_cast<uint8_t>(c), static_cast<uint8_t>(c + 2*i), 0, 0 );
+    for( uint16_t y = 0; y < 4; ++y )
+      for( uint16_t x = 0; x < 4; ++x )
+        gif[i].SetPixel( x, y, static_cast<uint8_t>(x) );
+  }
+  gif[1].SetPixel( 0, 0, 15 );
+  gif[1].TransColor( 15 );
+
+  auto Frames = Timeline( gif );
+  CPPUNIT_ASSERT( Run( Pass::SingleColorTable, gif ) );
+  CPPUNIT_ASSERT( gif.ColorTable() && gif.ColorTableSize() == 8 );
+  CPPUNIT_ASSERT( !gif[0].ColorTable() && !gif[1].ColorTable() );
+  CPPUNIT_ASSERT( gif[1].HasTransColor() && gif[1].TransColor() == 6 );
+  CPPUNIT_ASSERT( Timeline( gif ) == Frames );
+
+  // no smaller
+  CPPUNIT_ASSERT( !Run( Pass::SingleColorTable, gif ) );
+}
+
+void GifPassManagerTest::testCommonColorTable()
+{
+  // 0: local, colors 0-3, 1: global, colors 1-2, 2: local, colors 8-15
+  vp::Gif gif( 4, 4, 4, 3 );
+  for( uint16_t c = 0; c < 16; ++c )
+    gif.SetColorTable( static_cast<uint8_t>(c), 0, static_cast<uint8_t>(c), 0 );
+  for( size_t i : { 0, 2 } )
+  {
+    gif[i].ColorTableSize( 16 );
+    for( uint16_t c = 0; c < 16; ++c )
+      gif[i].SetColorTable( static_cast<uint8_t>(c), 0, static_cast<uint8_t>(c), 0 );
+  }
+
+  for( uint16_t y = 0; y < 4; ++y )
+    for( uint16_t x = 0; x < 4; ++x )
+    {
+      gif[0].SetPixel( x, y, static_cast<uint8_t>(x) );
+      gif[1].SetPixel( x, y, static_cast<uint8_t>(1 + (x + y) % 2) );
+      gif[2].SetPixel( x, y, static_cast<uint8_t>(8 + (x + 4*y) % 8) );
+    }
+
+  auto Frames = Timeline( gif );
+  CPPUNIT_ASSERT( Run( Pass::CommonColorTable, gif ) );
+  CPPUNIT_ASSERT( gif.ColorTableSize() == 4 );
+  CPPUNIT_ASSERT( !gif[0].ColorTable() && !gif[1].ColorTable() );
+  CPPUNIT_ASSERT( gif[2].ColorTable() && gif[2].ColorTableSize() == 8 );
+  CPPUNIT_ASSERT( Timeline( gif ) == Frames );
+
+  // nothing to share
+  CPPUNIT_ASSERT( !Run( Pass::CommonColorTable, gif ) );
+}
+
+void GifPassManagerTest::testLocalColorTables()
+{
+  vp::Gif gif = MakeGif( 4, 4, 2, []( size_t, uint16_t x, uint16_t ) {
+    return static_cast<uint8_t>(x % 3); } );
+  for( size_t i = 0; i < 2; ++i )
+  {
+    gif[i].ColorTableSize( 16 );
+    for( uint16_t c = 0; c < 16; ++c )
+      gif[i].SetColorTable( static_cast<uint8_t>(c), 0, 0, static_cast<uint8_t>(15 - c) );
+  }
+  gif[1].TransColor( 2 );
+
+  auto Frames = Timeline( gif );
+  CPPUNIT_ASSERT( Run( Pass::LocalColorTables, gif ) );
+  CPPUNIT_ASSERT( !gif.ColorTable() );
+  CPPUNIT_ASSERT( gif[0].ColorTableSize() == 4 && gif[1].ColorTableSize() == 4 );
+  CPPUNIT_ASSERT( gif[1].HasTransColor() && gif[1].TransColor() == 2 );
+  CPPUNIT_ASSERT( Timeline( gif ) == Frames );
+  CPPUNIT_ASSERT( !Run( Pass::LocalColorTables, gif ) );
+}
+
+void GifPassManagerTest::testReduceBpp()
+{
+  vp::Gif gif = MakeGif( 4, 4, 3, []( size_t i, uint16_t x, uint16_t ) {
+    return static_cast<uint8_t>(i == 2? 9 : x % 3); } );
+  gif[1].TransColor( 7 );
+
+  auto Frames = Timeline( gif );
+  CPPUNIT_ASSERT( Run( Pass::ReduceBpp, gif ) );
+  CPPUNIT_ASSERT( gif[0].BitsPerPixel() == 2 );
+  CPPUNIT_ASSERT( gif[1].BitsPerPixel() == 3 );
+  CPPUNIT_ASSERT( gif[2].BitsPerPixel() == 4 );
+  CPPUNIT_ASSERT( Timeline( gif ) == Frames );
+
+  // the same once written and read back
+  std::vector<uint8_t> Data;
+  gif.ExportTo( Data );
+  vp::Gif gif2;
+  gif2.Import( Data.data(), Data.size() );
+  CPPUNIT_ASSERT( Timeline( gif2 ) == Frames );
+}
+
+void GifPassManagerTest::testDownsize()
+{
+  // full frames, a square moving over a background, every other frame repeated
+  vp::Gif gif = MakeGif( 32, 16, 12, []( size_t i, uint16_t x, uint16_t y ) {
+    size_t Step = i/2;
+    bool Square = x >= Step*2 && x < Step*2 + 4 && y >= 4 && y < 8;
+    return static_cast<uint8_t>(Square? 9 : (x/8 + y/8) % 2 + 3); } );
+
+  std::vector<uint8_t> Data;
+  gif.ExportTo( Data );
+  auto Frames = Timeline( gif );
+
+  auto Results = vp::GifPassManager::Downsize().Run( gif, true );
+  CPPUNIT_ASSERT( Results.size() == 7 );
+  CPPUNIT_ASSERT( Results.front().SizeBefore == Data.size() );
+  CPPUNIT_ASSERT( Results.back().SizeAfter < Data.size()/2 );
+  CPPUNIT_ASSERT( Results[0].Changed && Results[1].Changed );
+  CPPUNIT_ASSERT( gif.Images() == 6 );
+  for( size_t i = 1; i < Results.size(); ++i )
+    CPPUNIT_ASSERT( Results[i].SizeBefore == Results[i - 1].SizeAfter );
+
+  CPPUNIT_ASSERT( Timeline( gif ) == Frames );
+  gif.ExportTo( Data );
+  vp::Gif gif2;
+  gif2.Import( Data.data(), Data.size() );
+  CPPUNIT_ASSERT( Timeline( gif2 ) == Frames );
+}
@@ -0,0 +1,285 @@
+////////////////////////////////////////////////////////////////////////
+// Copyright (C) 2019 Xueyi Yao
+//
+// This file is part of VPixels.
+//
+// VPixels is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+// 
+// VPixels is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+// 
+// You should have received a copy of the GNU General Public License
+// along with VPixels.  If not, see <https://www.gnu.org/licenses/>.
+////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////
+
+#include <cstdlib>
+#include <cstring>
+#include <vector>
+#include "GifRendererTest.h"
+#include "GifRenderer.h"
+#include "Gif.h"
+#include "GifImage.h"
+#include "Exception.h"
+
+CPPUNIT_TEST_SUITE_REGISTRATION( GifRendererTest );
+
+namespace
+{
+  // color i of the global color table is (i, 2i, 3i)
+  vp::Gif MakeGif( const uint16_t Width, const uint16_t Height, const size_t Images )
+  {
+    vp::Gif gif( 4, Width, Height, Images );
+    for( uint16_t i = 0; i < 16; ++i )
+      gif.SetColorTable( static_cast<uint8_t>(i), static_cast<uint8_t>(i),
+                         static_cast<uint8_t>(2*i), static_cast<uint8_t>(3*i) );
+    return gif;
+  }
+
+  // pixel (X, Y) of a canvas is color Index, or transparent if Index < 0
+  bool IsColor( const vp::GifRenderer& Renderer, const uint8_t* pCanvas,
+                const uint16_t X, const uint16_t Y, const int Index )
+  {
+    const uint8_t* p = pCanvas + 4*(Y*Renderer.Width() + X);
+    if( Index < 0 )
+      return p[3] == 0;
+
+    return p[0] == Index && p[1] == 2*Index && p[2] == 3*Index && p[3] == 255;
+  }
+}
+
+void GifRendererTest::testCtor()
+{
+  vp::Gif gif = MakeGif( 5, 3, 2 );
+  vp::GifRenderer renderer( gif );
+  CPPUNIT_ASSERT( renderer.Width() == 5 );
+  CPPUNIT_ASSERT( renderer.Height() == 3 );
+
+  CPPUNIT_ASSERT( renderer.Render( 0 ) != nullptr );
+  CPPUNIT_ASSERT( renderer.Render( 1 ) != nullptr );
+  CPPUNIT_ASSERT_THROW( renderer.Render( 2 ), vp::Exception );
+}
+
+void GifRendererTest::testDisposal()
+{
+  // 8 x 4 screen
+  vp::Gif gif = MakeGif( 8, 4, 5 );
+
+  // 0: all 1, except a transparent pixel at (7, 3)
+  gif[0].SetAllPixels( 1 );
+  gif[0].SetPixel( 7, 3, 15 );
+  gif[0].TransColor( 15 );
+
+  // 1: 3 x 2 at (2, 1), restored to previous
+  gif[1].Crop( 2, 1, 3, 2 );
+  gif[1].SetAllPixels( 2 );
+  gif[1].DisposalMethod( 3 );
+
+  // 2: 4 x 4 at (4, 0), restored to background, top row transparent
+  gif[2].Crop( 4, 0, 4, 4 );
+  gif[2].SetAllPixels( 3 );
+  for( uint16_t x = 0; x < 4; ++x )
+    gif[2].SetPixel( x, 0, 14 );
+  gif[2].TransColor( 14 );
+  gif[2].DisposalMethod( 2 );
+
+  // 3: 2 x 1 at (0, 3), left in place
+  gif[3].Crop( 0, 3, 2, 1 );
+  gif[3].SetAllPixels( 4 );
+  gif[3].DisposalMethod( 1 );
+
+  // 4: 1 x 1 at (3, 0)
+  gif[4].Crop( 3, 0, 1, 1 );
+  gif[4].SetAllPixels( 5 );
+
+  vp::GifRenderer renderer( gif );
+  const uint8_t* p = renderer.Render( 0 );
+  CPPUNIT_ASSERT( IsColor( renderer, p, 0, 0, 1 ) );
+  CPPUNIT_ASSERT( IsColor( renderer, p, 6, 3, 1 ) );
+  CPPUNIT_ASSERT( IsColor( renderer, p, 7, 3, -1 ) );
+
+  p = renderer.Render( 1 );
+  CPPUNIT_ASSERT( IsColor( renderer, p, 1, 1, 1 ) );
+  CPPUNIT_ASSERT( IsColor( renderer, p, 2, 1, 2 ) );
+  CPPUNIT_ASSERT( IsColor( renderer, p, 4, 2, 2 ) );
+  CPPUNIT_ASSERT( IsColor( renderer, p, 5, 2, 1 ) );
+  CPPUNIT_ASSERT( IsColor( renderer, p, 7, 3, -1 ) );
+
+  // image 1 restored, image 2 drawn, except its top row
+  p = renderer.Render( 2 );
+  CPPUNIT_ASSERT( IsColor( renderer, p, 2, 1, 1 ) );
+  CPPUNIT_ASSERT( IsColor( renderer, p, 4, 2, 3 ) );
+  CPPUNIT_ASSERT( IsColor( renderer, p, 4, 0, 1 ) );
+  CPPUNIT_ASSERT( IsColor( renderer, p, 7, 0, 1 ) );
+  CPPUNIT_ASSERT( IsColor( renderer, p, 7, 3, 3 ) );
+  CPPUNIT_ASSERT( IsColor( renderer, p, 3, 3, 1 ) );
+
+  // image 2 cleared to transparent background, top row included
+  p = renderer.Render( 3 );
+  CPPUNIT_ASSERT( IsColor( renderer, p, 0, 3, 4 ) );
+  CPPUNIT_ASSERT( IsColor( renderer, p, 1, 3, 4 ) );
+  CPPUNIT_ASSERT( IsColor( renderer, p, 2, 3, 1 ) );
+  CPPUNIT_ASSERT( IsColor( renderer, p, 3, 3, 1 ) );
+  for( uint16_t y = 0; y < 4; ++y )
+    for( uint16_t x = 4; x < 8; ++x )
+      CPPUNIT_ASSERT( IsColor( renderer, p, x, y, -1 ) );
+
+  // image 3 left in place
+  p = renderer.Render( 4 );
+  CPPUNIT_ASSERT( IsColor( renderer, p, 0, 3, 4 ) );
+  CPPUNIT_ASSERT( IsColor( renderer, p, 3, 0, 5 ) );
+  CPPUNIT_ASSERT( IsColor( renderer, p, 2, 0, 1 ) );
+  CPPUNIT_ASSERT( IsColor( renderer, p, 4, 0, -1 ) );
+}
+
+void GifRendererTest::testBackground()
+{
+  vp::Gif gif = MakeGif( 4, 2, 2 );
+  gif.BackgroundColor( 6 );
+  gif[0].SetAllPixels( 1 );
+  gif[0].DisposalMethod( 2 );
+  gif[1].Crop( 0, 0, 1, 1 );
+  gif[1].SetAllPixels( 2 );
+
+  // transparent by default
+  vp::GifRenderer renderer1( gif );
+  const uint8_t* p = renderer1.Render( 1 );
+  CPPUNIT_ASSERT( IsColor( renderer1, p, 0, 0, 2 ) );
+  CPPUNIT_ASSERT( IsColor( renderer1, p, 3, 1, -1 ) );
+
+  // background color
+  vp::GifRenderer renderer2( gif, true );
+  p = renderer2.Render( 1 );
+  CPPUNIT_ASSERT( IsColor( renderer2, p, 0, 0, 2 ) );
+  CPPUNIT_ASSERT( IsColor( renderer2, p, 3, 1, 6 ) );
+
+  // transparent pixels show the background
+  gif[0].TransColor( 1 );
+  renderer2.Reset();
+  p = renderer2.Render( 0 );
+  CPPUNIT_ASSERT( IsColor( renderer2, p, 2, 1, 6 ) );
+
+  // transparent without a global color table
+  vp::Gif gif2( 4, 4, 2, 2, false );
+  vp::GifRenderer renderer3( gif2, true );
+  gif2[0].TransColor( 0 );
+  p = renderer3.Render( 0 );
+  CPPUNIT_ASSERT( IsColor( renderer3, p, 0, 0, -1 ) );
+}
+
+void GifRendererTest::testSeek()
+{
+  // 40 frames of every disposal method, moving around a 16 x 12 screen
+  vp::Gif gif = MakeGif( 16, 12, 40 );
+  gif[0].SetAllPixels( 0 );
+  for( size_t i = 1; i < gif.Images(); ++i )
+  {
+    vp::GifImage& img = gif[i];
+    uint16_t x = static_cast<uint16_t>((i*5) % 12);
+    uint16_t y = static_cast<uint16_t>((i*3) % 8);
+    img.Crop( x, y, 4, 4 );
+    for( uint16_t v = 0; v < 4; ++v )
+      for( uint16_t u = 0; u < 4; ++u )
+        img.SetPixel( u, v, static_cast<uint8_t>((i + u*v) % 16) );
+    img.TransColor( static_cast<uint8_t>(i % 16) );
+    img.DisposalMethod( static_cast<uint8_t>(i % 4) );
+  }
+
+  // frames rendered one after another
+  size_t Size = 4*16*12;
+  std::vector<std::vector<uint8_t>> Frames;
+  vp::GifRenderer renderer( gif, false, 0 );
+  for( size_t i = 0; i < gif.Images(); ++i )
+  {
+    const uint8_t* p = renderer.Render( i );
+    Frames.emplace_back( p, p + Size );
+  }
+
+  // the same, rendered in any order
+  const size_t Order[] = { 39, 3, 17, 16, 15, 0, 33, 32, 8, 7, 39, 21, 20, 5, 38, 1, 1 };
+  for( size_t Interval : { 0u, 1u, 4u, 7u, 16u, 64u } )
+  {
+    vp::GifRenderer renderer2( gif, false, Interval );
+    for( size_t i : Order )
+      CPPUNIT_ASSERT( std::memcmp( renderer2.Render( i ), Frames[i].data(), Size ) == 0 );
+  }
+}
+
+void GifRendererTest::testReset()
+{
+  vp::Gif gif = MakeGif( 3, 3, 2 );
+  gif[0].SetAllPixels( 1 );
+  gif[1].SetAllPixels( 2 );
+
+  vp::GifRenderer renderer( gif, false, 1 );
+  CPPUNIT_ASSERT( IsColor( renderer, renderer.Render( 1 ), 1, 1, 2 ) );
+
+  // changes show after reset
+  gif[0].SetAllPixels( 3 );
+  gif[1].SetAllPixels( 4 );
+  gif.CropAll( 0, 0, 2, 2 );
+  renderer.Reset();
+  CPPUNIT_ASSERT( renderer.Width() == 2 && renderer.Height() == 2 );
+  CPPUNIT_ASSERT( IsColor( renderer, renderer.Render( 0 ), 1, 1, 3 ) );
+  CPPUNIT_ASSERT( IsColor( renderer, renderer.Render( 1 ), 1, 1, 4 ) );
+}
+
+void GifRendererTest::testCropAll()
+{
+  // images of random position, dimension, pixels, transparent color
+  // and disposal method, some of them outside the region cropped
+  srand( 3 );
+  vp::Gif gif = MakeGif( 12, 10, 24 );
+  for( size_t i = 0; i < gif.Images(); ++i )
+  {
+    uint16_t Left = static_cast<uint16_t>(rand() % 11);
+    uint16_t Top = static_cast<uint16_t>(rand() % 9);
+    uint16_t Width = static_cast<uint16_t>(rand() % (12 - Left) + 1);
+    uint16_t Height = static_cast<uint16_t>(rand() % (10 - Top) + 1);
+
+    // outside and restored to background, then a frame transparent at
+    // the top left corner of the region
+    if( i == 5 )
+      gif[i].Crop( 0, 0, 2, 2 );
+    else if( i == 6 )
+      gif[i].Crop( 3, 2, 4, 4 );
+    else
+      gif[i].Crop( Left, Top, Width, Height );
+
+    for( uint16_t y = 0; y < gif[i].Height(); ++y )
+      for( uint16_t x = 0; x < gif[i].Width(); ++x )
+        gif[i].SetPixel( x, y, static_cast<uint8_t>(rand() % 4) );
+
+    if( rand() % 2 == 0 )
+      gif[i].TransColor( 0 );
+    gif[i].DisposalMethod( static_cast<uint8_t>(rand() % 4) );
+  }
+
+  gif[5].DisposalMethod( 2 );
+  gif[6].SetAllPixels( 0 );
+  gif[6].TransColor( 0 );
+
+  const uint16_t Left = 3, Top = 2, Width = 6, Height = 5;
+  for( bool Background : { false, true } )
+  {
+    vp::Gif cropped = gif;
+    cropped.CropAll( Left, Top, Width, Height );
+    CPPUNIT_ASSERT( cropped[5].DisposalMethod() == 1 );
+
+    vp::GifRenderer renderer( gif, Background );
+    vp::GifRenderer croppedRenderer( cropped, Background );
+    for( size_t i = 0; i < gif.Images(); ++i )
+    {
+      const uint8_t* pFrame = renderer.Render( i );
+      const uint8_t* pCropped = croppedRenderer.Render( i );
+      for( uint16_t y = 0; y < Height; ++y )
+        CPPUNIT_ASSERT( std::memcmp( pCropped + 4*Width*y,
+                                     pFrame + 4*(12*(Top + y) + Left), 4*Width ) == 0 );
+    }
+  }
+}
@@ -70,3 +70,27 @@ void GifStringTableTest::testWithIndex()
   CPPUNIT_ASSERT( st.Search( 34, 2, index1 ) == 0 );
   CPPUNIT_ASSERT( st.Search( 258, 9, index1 ) == 0 );
 }
+
+// test Reset() many times, more than the number of generations
+void GifStringTableTest::testReset()
+{
+  GifStringTable st;
+  uint16_t index;
+
+  for( uint32_t i = 0; i < 70000; ++i )
+  {
+    uint16_t String = static_cast<uint16_t>(i & 0x0FFF);
+    uint8_t  Pixel = static_cast<uint8_t>(i & 0xFF);
+
+    // entries of previous generation are gone
+    CPPUNIT_ASSERT( st.Search( 4, 1 ) == 0 );
+    CPPUNIT_ASSERT( st.Search( String, Pixel, index ) == 0 );
+
+    st.Add( index, String, Pixel, 258 );
+    st.Add( 4, 1, 5 );
+    CPPUNIT_ASSERT( st.Search( 4, 1 ) == 5 );
+    CPPUNIT_ASSERT( st.Search( String, Pixel ) == 258 );
+
+    st.Reset();
+  }
+}
@@ -31,12 +31,14 @@ class GifStringTableTest : public CPPUNIT_NS::TestCase
 
   CPPUNIT_TEST( testNoIndex );
   CPPUNIT_TEST( testWithIndex );
+  CPPUNIT_TEST( testReset );
 
   CPPUNIT_TEST_SUITE_END();
 
 protected:
   void testNoIndex();
   void testWithIndex();
+  void testReset();
 
 };
 
@@ -0,0 +1,164 @@
+////////////////////////////////////////////////////////////////////////
+// Copyright (C) 2019 Xueyi Yao
+//
+// This file is part of VPixels.
+//
+// VPixels is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+// 
+// VPixels is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+// 
+// You should have received a copy of the GNU General Public License
+// along with VPixels.  If not, see <https://www.gnu.org/licenses/>.
+////////////////////////////////////////////////////////////////////////
+
+#include <cstdlib>
+#include <sstream>
+#include "GifSubBlockReaderTest.h"
+#include "GifSubBlockReader.h"
+#include "GifCodeWriter.h"
+#include "GifBlockIO.h"
+#include "GifEncoder.h"
+#include "GifFastDecoder.h"
+#include "Exception.h"
+
+CPPUNIT_TEST_SUITE_REGISTRATION( GifSubBlockReaderTest );
+
+namespace
+{
+  // code of the i-th code size
+  inline uint8_t CodeSize( const uint16_t i )
+  {
+    return static_cast<uint8_t>(i % 12 + 1);
+  }
+
+  inline uint16_t Code( const uint16_t i )
+  {
+    return static_cast<uint16_t>((i*37) & (0xFFFF >> (16 - CodeSize(i))));
+  }
+
+  // 2000 codes of mixed sizes, 12984 bits, 1623 bytes, 7 sub-blocks
+  U8String Codes()
+  {
+    U8String Codes;
+    GifCodeWriter WriteCode( Codes );
+    for( uint16_t i = 0; i < 2000; ++i )
+      WriteCode( Code(i), CodeSize(i) );
+    WriteCode.End();
+
+    return Codes;
+  }
+
+  // sub-block chain of Codes, followed by a byte of 0x3B
+  std::string SubBlocks( const U8String& Codes )
+  {
+    std::ostringstream os;
+    GifBlockIO::WriteSubBlocks( os, Codes );
+    os.put( 0x3B );
+
+    return os.str();
+  }
+}
+
+// read codes from buffer
+void GifSubBlockReaderTest::testBuffer()
+{
+  U8String Data = Codes();
+  CPPUNIT_ASSERT( Data.size() == 1623 );
+
+  std::string Chain = SubBlocks( Data );
+  CPPUNIT_ASSERT( Chain.size() == 1623 + 7 + 1 + 1 );
+
+  const uint8_t* pData = reinterpret_cast<const uint8_t*>(Chain.data());
+  GifSubBlockReader ReadCode( pData, Chain.size() );
+  for( uint16_t i = 0; i < 2000; ++i )
+    CPPUNIT_ASSERT( ReadCode( CodeSize(i) ) == Code(i) );
+
+  // no bits left
+  uint16_t Code;
+  CPPUNIT_ASSERT( !ReadCode( 1, Code ) );
+  CPPUNIT_ASSERT_THROW( ReadCode(1), vp::Exception );
+
+  // position is right after terminating byte
+  CPPUNIT_ASSERT( ReadCode.Position() == Chain.size() - 1 );
+  CPPUNIT_ASSERT( pData[ReadCode.Position()] == 0x3B );
+}
+
+// chain of terminating byte only
+void GifSubBlockReaderTest::testEmpty()
+{
+  const uint8_t Data[] = { 0x00, 0x3B };
+  uint16_t Code;
+  GifSubBlockReader ReadBuffer( Data, sizeof(Data) );
+  CPPUNIT_ASSERT( !ReadBuffer( 1, Code ) );
+  CPPUNIT_ASSERT( ReadBuffer.Position() == 1 );
+
+  GifSubBlockReader ReadNothing( Data, 0 );
+  CPPUNIT_ASSERT( !ReadNothing( 1, Code ) );
+  CPPUNIT_ASSERT( ReadNothing.Position() == 0 );
+}
+
+// sub-block is shorter than its size, no terminating byte
+void GifSubBlockReaderTest::testTruncated()
+{
+  const uint8_t Data[] = { 0x05, 0x12, 0x34 };
+  uint16_t Code;
+
+  GifSubBlockReader ReadBuffer( Data, sizeof(Data) );
+  CPPUNIT_ASSERT( ReadBuffer( 16, Code ) );
+  CPPUNIT_ASSERT( Code == 0x3412 );
+  CPPUNIT_ASSERT( !ReadBuffer( 1, Code ) );
+  CPPUNIT_ASSERT( ReadBuffer.Position() == sizeof(Data) );
+}
+
+// skip sub-blocks that are not read
+void GifSubBlockReaderTest::testSkip()
+{
+  std::string Chain = SubBlocks( Codes() );
+
+  const uint8_t* pData = reinterpret_cast<const uint8_t*>(Chain.data());
+  GifSubBlockReader ReadCode( pData, Chain.size() );
+  // 1st 12 bits are codes of 1, 2, 3, 4 bits and 2 bits of the 5th
+  CPPUNIT_ASSERT( ReadCode( 12 ) == (Code(0) | (Code(1) << 1) | (Code(2) << 3) |
+                                     (Code(3) << 6) | ((Code(4) & 0x03) << 10)) );
+  ReadCode.Skip();
+  CPPUNIT_ASSERT( ReadCode.Position() == Chain.size() - 1 );
+  CPPUNIT_ASSERT( pData[ReadCode.Position()] == 0x3B );
+
+  // reading after Skip()
+  uint16_t Code;
+  CPPUNIT_ASSERT( !ReadCode( 1, Code ) );
+}
+
+// decode straight from sub-blocks
+void GifSubBlockReaderTest::testDecode()
+{
+  srand( 3 );
+  for( uint8_t Bpp = 1; Bpp <= 8; ++Bpp )
+  {
+    U8String Pixels;
+    for( int i = 0; i < 50000; ++i )
+      Pixels.append( static_cast<size_t>(rand() % 8 + 1),
+                     static_cast<uint8_t>(rand() % (1 << Bpp)) );
+
+    U8String Data;
+    GifEncoder Encoder;
+    Encoder( Bpp, Pixels, Data );
+    std::string Chain = SubBlocks( Data );
+
+    GifSubBlockReader ReadCode( reinterpret_cast<const uint8_t*>(Chain.data()),
+                                Chain.size() );
+    U8String Decoded;
+    GifFastDecoder Decoder;
+    Decoder( Bpp, ReadCode, Decoded );
+    CPPUNIT_ASSERT( Decoded == Pixels );
+
+    ReadCode.Skip();
+    CPPUNIT_ASSERT( ReadCode.Position() == Chain.size() - 1 );
+  }
+}
@@ -0,0 +1,183 @@
+////////////////////////////////////////////////////////////////////////
+// Copyright (C) 2019 Xueyi Yao
+//
+// This file is part of VPixels.
+//
+// VPixels is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+// 
+// VPixels is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+// 
+// You should have received a copy of the GNU General Public License
+// along with VPixels.  If not, see <https://www.gnu.org/licenses/>.
+////////////////////////////////////////////////////////////////////////
+
+#include <cstdlib>
+#include <sstream>
+#include "GifSubBlockWriterTest.h"
+#include "GifSubBlockWriter.h"
+#include "GifCodeWriter.h"
+#include "GifBlockIO.h"
+#include "GifEncoder.h"
+
+CPPUNIT_TEST_SUITE_REGISTRATION( GifSubBlockWriterTest );
+
+namespace
+{
+  // sub-block chain of Codes written by GifBlockIO
+  U8String SubBlocks( const U8String& Codes )
+  {
+    std::ostringstream os;
+    GifBlockIO::WriteSubBlocks( os, Codes );
+    std::string Chain = os.str();
+
+    return U8String( reinterpret_cast<const uint8_t*>(Chain.data()), Chain.size() );
+  }
+
+  // write Count codes of CodeSize by GifCodeWriter and by
+  // GifSubBlockWriter to both stream and buffer, return true
+  // if the sub-block chains are the same
+  bool Compare( const uint8_t CodeSize, const size_t Count )
+  {
+    U8String Codes;
+    GifCodeWriter WriteCode( Codes );
+    for( size_t i = 0; i < Count; ++i )
+      WriteCode( static_cast<uint16_t>((i*37) & (0xFFFF >> (16 - CodeSize))), CodeSize );
+    WriteCode.End();
+    U8String Expected = SubBlocks( Codes );
+
+    std::ostringstream os;
+    U8String Buffer;
+    GifSubBlockWriter WriteStream( os ), WriteBuffer( Buffer );
+    for( size_t i = 0; i < Count; ++i )
+    {
+      uint16_t Code = static_cast<uint16_t>((i*37) & (0xFFFF >> (16 - CodeSize)));
+      WriteStream( Code, CodeSize );
+      WriteBuffer( Code, CodeSize );
+    }
+    WriteStream.End();
+    WriteBuffer.End();
+
+    std::string Chain = os.str();
+    return Buffer == Expected &&
+           Chain == std::string( reinterpret_cast<const char*>(Expected.data()),
+                                 Expected.size() );
+  }
+}
+
+// terminating byte only
+void GifSubBlockWriterTest::testEmpty()
+{
+  U8String Buffer;
+  GifSubBlockWriter WriteCode( Buffer );
+  WriteCode.End();
+  CPPUNIT_ASSERT( Buffer.size() == 1 );
+  CPPUNIT_ASSERT( Buffer[0] == 0x00 );
+
+  CPPUNIT_ASSERT( Compare( 8, 0 ) );
+}
+
+// data ends right before, at or after a sub-block boundary
+void GifSubBlockWriterTest::testBlockSize()
+{
+  for( size_t Count : { 1, 7, 8, 9, 254, 255, 256, 509, 510, 511, 2000 } )
+    CPPUNIT_ASSERT( Compare( 8, Count ) );
+
+  U8String Buffer;
+  GifSubBlockWriter WriteCode( Buffer );
+  for( uint16_t i = 0; i < 255; ++i )
+    WriteCode( i & 0xFF, 8 );
+  WriteCode.End();
+  CPPUNIT_ASSERT( Buffer.size() == 1 + 255 + 1 );
+  CPPUNIT_ASSERT( Buffer[0] == 255 );
+  CPPUNIT_ASSERT( Buffer[255] == 254 );
+  CPPUNIT_ASSERT( Buffer[256] == 0x00 );
+}
+
+// codes of all sizes, with partial last byte
+void GifSubBlockWriterTest::testMixed()
+{
+  for( uint8_t CodeSize = 1; CodeSize <= 12; ++CodeSize )
+    for( size_t Count : { 1, 3, 100, 1001, 5003 } )
+      CPPUNIT_ASSERT( Compare( CodeSize, Count ) );
+}
+
+// sub-blocks are appended to buffer
+void GifSubBlockWriterTest::testAppend()
+{
+  U8String Buffer;
+  Buffer += 0x08;
+  GifSubBlockWriter WriteCode( Buffer );
+  WriteCode( 0x0ABC, 12 );
+  WriteCode.End();
+
+  CPPUNIT_ASSERT( Buffer.size() == 5 );
+  CPPUNIT_ASSERT( Buffer[0] == 0x08 );
+  CPPUNIT_ASSERT( Buffer[1] == 2 );
+  CPPUNIT_ASSERT( Buffer[2] == 0xBC );
+  CPPUNIT_ASSERT( Buffer[3] == 0x0A );
+  CPPUNIT_ASSERT( Buffer[4] == 0x00 );
+}
+
+// packed codes appended at any bit, same as writing them one by one
+void GifSubBlockWriterTest::testAppendBits()
+{
+  srand( 4 );
+
+  U8String Codes, Buffer;
+  GifCodeWriter WriteExpected( Codes );
+  GifSubBlockWriter WriteCode( Buffer );
+  for( size_t Count : { 0, 1, 5, 6, 11, 12, 100, 1000 } )
+  {
+    // a code that shifts the packed ones
+    uint8_t CodeSize = static_cast<uint8_t>(rand() % 12 + 1);
+    WriteExpected( 1, CodeSize );
+    WriteCode( 1, CodeSize );
+
+    U8String Packed;
+    GifCodeWriter WritePacked( Packed );
+    size_t Bits = 0;
+    for( size_t i = 0; i < Count; ++i )
+    {
+      CodeSize = static_cast<uint8_t>(rand() % 12 + 1);
+      uint16_t Code = static_cast<uint16_t>(rand() & (0xFFFF >> (16 - CodeSize)));
+      WriteExpected( Code, CodeSize );
+      WritePacked( Code, CodeSize );
+      Bits += CodeSize;
+    }
+    WritePacked.End();
+
+    WriteCode.Append( Packed.data(), Bits );
+  }
+  WriteExpected.End();
+  WriteCode.End();
+
+  CPPUNIT_ASSERT( Buffer == SubBlocks( Codes ) );
+}
+
+// GifEncoder writes the same chain either way
+void GifSubBlockWriterTest::testEncode()
+{
+  srand( 5 );
+  for( uint8_t Bpp = 1; Bpp <= 8; ++Bpp )
+  {
+    U8String Pixels;
+    for( int i = 0; i < 20000; ++i )
+      Pixels.append( static_cast<size_t>(rand() % 8 + 1),
+                     static_cast<uint8_t>(rand() % (1 << Bpp)) );
+
+    GifEncoder Encoder;
+    U8String Codes;
+    Encoder( Bpp, Pixels, Codes );
+
+    U8String Buffer;
+    GifSubBlockWriter WriteCode( Buffer );
+    Encoder( Bpp, Pixels, WriteCode );
+    CPPUNIT_ASSERT( Buffer == SubBlocks( Codes ) );
+  }
+}
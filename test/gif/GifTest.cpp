@@ -17,9 +17,15 @@
 // along with VPixels.  If not, see <https://www.gnu.org/licenses/>.
 ////////////////////////////////////////////////////////////////////////
 
+#include <algorithm>
+#include <iterator>
+#include <sstream>
+#include <thread>
+#include <vector>
 #include "GifTest.h"
 #include "Gif.h"
 #include "GifImage.h"
+#include "GifRenderer.h"
 #include "Exception.h"
 
 CPPUNIT_TEST_SUITE_REGISTRATION( GifTest );
@@ -278,6 +284,540 @@ void GifTest::testExport()
   CPPUNIT_ASSERT( gif.Export( "export_new.gif" ) );
 }
 
+// Import(), ImportFrom() and ExportTo() in memory
+void GifTest::testMemoryIO()
+{
+  vp::Gif gif( 4, 20, 10, 2 );
+  gif[0].SetPixel( 3, 4, 5 );
+  gif[1].SetPixel( 19, 9, 15 );
+  gif.SetColorTable( 5, 10, 20, 30 );
+
+  std::vector<uint8_t> Data;
+  gif.ExportTo( Data );
+  CPPUNIT_ASSERT( Data.size() == gif.Size() );
+  CPPUNIT_ASSERT( Data.back() == 0x3B );
+
+  std::ostringstream os;
+  gif.ExportTo( os );
+  CPPUNIT_ASSERT( os.str() == std::string( Data.begin(), Data.end() ) );
+
+  // Data is replaced
+  gif.ExportTo( Data );
+  CPPUNIT_ASSERT( Data.size() == gif.Size() );
+
+  vp::Gif gif1;
+  gif1.Import( Data.data(), Data.size() );
+  CPPUNIT_ASSERT( gif1.Images() == 2 );
+  CPPUNIT_ASSERT( gif1.Width() == 20 );
+  CPPUNIT_ASSERT( gif1[0].GetPixel( 3, 4 ) == 5 );
+  CPPUNIT_ASSERT( gif1[1].GetPixel( 19, 9 ) == 15 );
+  uint8_t R, G, B;
+  gif1.GetColorTable( 5, R, G, B );
+  CPPUNIT_ASSERT( R == 10 && G == 20 && B == 30 );
+
+  vp::Gif gif2;
+  std::istringstream is( os.str() );
+  gif2.ImportFrom( is );
+  CPPUNIT_ASSERT( gif2.Images() == 2 );
+  CPPUNIT_ASSERT( gif2[1].GetPixel( 19, 9 ) == 15 );
+
+  // not valid
+  vp::Gif gif3;
+  CPPUNIT_ASSERT_THROW( gif3.Import( nullptr, 0 ), vp::Exception );
+  CPPUNIT_ASSERT_THROW( gif3.Import( Data.data(), 6 ), vp::Exception );
+  CPPUNIT_ASSERT_THROW( gif3.Import( Data.data(), Data.size() - 1 ), vp::Exception );
+  std::istringstream empty;
+  CPPUNIT_ASSERT_THROW( gif3.ImportFrom( empty ), vp::Exception );
+}
+
+// images decoded on first access to pixels
+void GifTest::testLazyImport()
+{
+  vp::Gif gif( 4, 20, 10, 3 );
+  gif[0].SetPixel( 3, 4, 5 );
+  gif[1].SetPixel( 19, 9, 15 );
+  gif[2].Delay( 7 );
+  std::vector<uint8_t> Data;
+  gif.ExportTo( Data );
+
+  vp::Gif gif1;
+  gif1.Import( Data.data(), Data.size(), true );
+  CPPUNIT_ASSERT( gif1.Images() == 3 );
+  CPPUNIT_ASSERT( gif1[2].Delay() == 7 );
+  CPPUNIT_ASSERT( gif1[1].Width() == 20 );
+  CPPUNIT_ASSERT( gif1.Size() == Data.size() );
+
+  // exported without being decoded
+  std::vector<uint8_t> Data1;
+  gif1.ExportTo( Data1 );
+  CPPUNIT_ASSERT( Data1 == Data );
+
+  // decoded
+  CPPUNIT_ASSERT( gif1[0].GetPixel( 3, 4 ) == 5 );
+  CPPUNIT_ASSERT( gif1[0] == gif[0] );
+  gif1[1].SetPixel( 0, 0, 1 );
+  CPPUNIT_ASSERT( gif1[1].GetPixel( 19, 9 ) == 15 );
+  gif1[2].BitsPerPixel( 3 );
+  CPPUNIT_ASSERT( gif1[2] == gif[2] );
+
+  // stream
+  vp::Gif gif2;
+  std::istringstream is( std::string( Data.begin(), Data.end() ) );
+  gif2.ImportFrom( is, true );
+  CPPUNIT_ASSERT( gif2[1].GetPixel( 19, 9 ) == 15 );
+
+  // image data does not match width of image
+  const uint8_t Descriptor[] = { 0x2C, 0, 0, 0, 0, 20, 0, 10, 0 };
+  auto it = std::search( Data.begin(), Data.end(),
+                         std::begin(Descriptor), std::end(Descriptor) );
+  CPPUNIT_ASSERT( it != Data.end() );
+  it[5] = 19;
+
+  // eager import throws, lazy import throws on first access
+  vp::Gif gif3;
+  CPPUNIT_ASSERT_THROW( gif3.Import( Data.data(), Data.size() ), vp::Exception );
+
+  vp::Gif gif4;
+  gif4.Import( Data.data(), Data.size(), true );
+  CPPUNIT_ASSERT( gif4[0].Width() == 19 );
+  CPPUNIT_ASSERT_THROW( gif4[0].GetPixel( 0, 0 ), vp::Exception );
+  CPPUNIT_ASSERT( gif4[1].GetPixel( 19, 9 ) == 15 );
+}
+
+// images decoded on multiple threads
+void GifTest::testThreads()
+{
+  vp::Gif gif( 8, 40, 30, 12 );
+  for( size_t i = 0; i < gif.Images(); ++i )
+    for( uint16_t y = 0; y < 30; ++y )
+      for( uint16_t x = 0; x < 40; ++x )
+        gif[i].SetPixel( x, y, static_cast<uint8_t>((x*y + i) & 0xFF) );
+  std::vector<uint8_t> Data;
+  gif.ExportTo( Data );
+
+  // serial by default
+  vp::Gif gif1;
+  CPPUNIT_ASSERT( gif1.Threads() == 1 );
+
+  for( unsigned Threads : { 0u, 3u, 16u } )
+  {
+    gif1.Threads( Threads );
+    gif1.Import( Data.data(), Data.size() );
+    CPPUNIT_ASSERT( gif1.Threads() == Threads );
+    CPPUNIT_ASSERT( gif1.Images() == 12 );
+    for( size_t i = 0; i < gif.Images(); ++i )
+      CPPUNIT_ASSERT( gif1[i] == gif[i] );
+  }
+
+  // copied
+  vp::Gif gif2( gif1 );
+  CPPUNIT_ASSERT( gif2.Threads() == 16 );
+
+  // exported on multiple threads, same as on a single thread
+  gif.Threads( 4 );
+  std::vector<uint8_t> Data2;
+  gif.ExportTo( Data2 );
+  CPPUNIT_ASSERT( Data2 == Data );
+  CPPUNIT_ASSERT( gif.Size() == Data.size() );
+
+  gif2[3].SetPixel( 1, 2, 3 );
+  gif2[7].BitsPerPixel( 7 );
+  gif2.Threads( 1 );
+  std::vector<uint8_t> Serial;
+  gif2.ExportTo( Serial );
+  uint8_t Pixel = gif2[5].GetPixel( 5, 5 );
+  gif2[5].SetPixel( 5, 5, static_cast<uint8_t>(Pixel + 1) );
+  gif2[5].SetPixel( 5, 5, Pixel );
+  gif2.Threads( 0 );
+  gif2.ExportTo( Data2 );
+  CPPUNIT_ASSERT( Data2 == Serial );
+
+  // invalid image data
+  const uint8_t Descriptor[] = { 0x2C, 0, 0, 0, 0, 40, 0, 30, 0 };
+  auto it = std::find_end( Data.begin(), Data.end(),
+                           std::begin(Descriptor), std::end(Descriptor) );
+  CPPUNIT_ASSERT( it != Data.end() );
+  it[7] = 29;
+  CPPUNIT_ASSERT_THROW( gif1.Import( Data.data(), Data.size() ), vp::Exception );
+}
+
+void GifTest::testLazyThreads()
+{
+  vp::Gif gif( 8, 300, 200, 4 );
+  for( size_t i = 0; i < gif.Images(); ++i )
+    for( uint16_t y = 0; y < 200; ++y )
+      for( uint16_t x = 0; x < 300; ++x )
+        gif[i].SetPixel( x, y, static_cast<uint8_t>((x/3 + y/7 + i) & 0xFF) );
+  std::vector<uint8_t> Data;
+  gif.ExportTo( Data );
+
+  // threads read, or copy, the same lazily imported images at once
+  vp::Gif gif1;
+  gif1.Import( Data.data(), Data.size(), true );
+  const vp::Gif& Lazy = gif1;
+  const size_t Threads = 4;
+  std::vector<std::vector<uint8_t>> RGBA( Threads );
+  std::vector<std::vector<uint64_t>> Hash( Threads );
+  std::vector<std::thread> ThreadVec;
+  for( size_t t = 0; t < Threads; ++t )
+    ThreadVec.emplace_back( [&, t]()
+    {
+      std::vector<uint8_t> Pixels( 300 * 200 * 4 );
+      vp::Gif Copy( 8, 300, 200, 2 );
+      for( size_t i = 0; i < Lazy.Images(); ++i )
+      {
+        const size_t j = (i + t) % Lazy.Images();
+        if( t % 2 )
+          Copy[0] = Lazy[j];
+        const vp::GifImage& Image = (t % 2) ? Copy[0] : Lazy[j];
+        Hash[t].push_back( Image.Hash() );
+        Image.GetRGBA( Pixels.data() );
+        RGBA[t].insert( RGBA[t].end(), Pixels.begin(), Pixels.end() );
+      }
+    } );
+  for( auto& Thread : ThreadVec )
+    Thread.join();
+
+  std::vector<uint8_t> Pixels( 300 * 200 * 4 );
+  for( size_t t = 0; t < Threads; ++t )
+    for( size_t i = 0; i < gif.Images(); ++i )
+    {
+      const size_t j = (i + t) % gif.Images();
+      CPPUNIT_ASSERT( Hash[t][i] == gif[j].Hash() );
+      gif[j].GetRGBA( Pixels.data() );
+      CPPUNIT_ASSERT( std::equal( Pixels.begin(), Pixels.end(),
+                                  RGBA[t].begin() + static_cast<std::ptrdiff_t>(i * Pixels.size()) ) );
+    }
+  for( size_t i = 0; i < gif.Images(); ++i )
+    CPPUNIT_ASSERT( gif1[i] == gif[i] );
+}
+
+void GifTest::testImageThreads()
+{
+  // large enough for 3 chunks, the small image stays in one piece
+  vp::Gif gif( 8, 2048, 1536, 2 );
+  std::vector<uint8_t> Pixels( 2048 * 1536 );
+  for( size_t i = 0; i < gif.Images(); ++i )
+  {
+    for( size_t p = 0; p < Pixels.size(); ++p )
+      Pixels[p] = static_cast<uint8_t>((p % 2048 / 7 + p / 2048 / 5 + i) & 0xFF);
+    gif[i].SetRect( 0, 0, 2048, 1536, Pixels.data() );
+  }
+  gif[1].Crop( 0, 0, 20, 10 );
+  std::vector<uint8_t> Serial;
+  gif.ExportTo( Serial );
+
+  // serial by default, copied
+  CPPUNIT_ASSERT( gif.ImageThreads() == 1 );
+  vp::Gif gif1( gif );
+  gif1.ImageThreads( 3 );
+  CPPUNIT_ASSERT( vp::Gif( gif1 ).ImageThreads() == 3 );
+
+  std::vector<uint8_t> Data;
+  CPPUNIT_ASSERT( gif1.Size() != Serial.size() );
+  gif1.ExportTo( Data );
+  CPPUNIT_ASSERT( Data != Serial );
+  CPPUNIT_ASSERT( gif1.Size() == Data.size() );
+
+  vp::Gif gif2;
+  gif2.Import( Data.data(), Data.size() );
+  CPPUNIT_ASSERT( gif2.Images() == 2 );
+  for( size_t i = 0; i < gif.Images(); ++i )
+    CPPUNIT_ASSERT( gif2[i] == gif[i] );
+}
+
+void GifTest::testInterlaced()
+{
+  vp::Gif gif( 8, 37, 23, 3 );
+  for( size_t i = 0; i < gif.Images(); ++i )
+    for( uint16_t y = 0; y < 23; ++y )
+      for( uint16_t x = 0; x < 37; ++x )
+        gif[i].SetPixel( x, y, static_cast<uint8_t>((x + 3*y + i) & 0xFF) );
+  gif[0].Interlaced( true );
+  gif[2].Interlaced( true );
+  gif[2].Crop( 5, 6, 20, 15 );
+
+  auto SamePixels = [&]( const vp::GifImage& Image, const vp::GifImage& Original ) {
+    if( Image.Width() != Original.Width() || Image.Height() != Original.Height() )
+      return false;
+    for( uint16_t y = 0; y < Image.Height(); ++y )
+      for( uint16_t x = 0; x < Image.Width(); ++x )
+        if( Image.GetPixel( x, y ) != Original.GetPixel( x, y ) )
+          return false;
+    return true;
+  };
+
+  std::vector<uint8_t> Data;
+  gif.ExportTo( Data );
+  CPPUNIT_ASSERT( gif.Size() == Data.size() );
+
+  for( bool Lazy : { false, true } )
+  {
+    vp::Gif gif1;
+    gif1.Import( Data.data(), Data.size(), Lazy );
+    CPPUNIT_ASSERT( gif1[0].Interlaced() );
+    CPPUNIT_ASSERT( !gif1[1].Interlaced() );
+    CPPUNIT_ASSERT( gif1[2].Interlaced() );
+    for( size_t i = 0; i < gif.Images(); ++i )
+      CPPUNIT_ASSERT( SamePixels( gif1[i], gif[i] ) );
+
+    std::vector<uint8_t> Data1;
+    gif1.ExportTo( Data1 );
+    CPPUNIT_ASSERT( Data1 == Data );
+  }
+
+  // the same pixels, encoded in another order
+  gif[0].Interlaced( false );
+  std::vector<uint8_t> Data2;
+  gif.ExportTo( Data2 );
+  CPPUNIT_ASSERT( Data2 != Data );
+  vp::Gif gif2;
+  gif2.Import( Data2.data(), Data2.size() );
+  CPPUNIT_ASSERT( !gif2[0].Interlaced() );
+  CPPUNIT_ASSERT( SamePixels( gif2[0], gif[0] ) );
+}
+
+void GifTest::testBulkPixels()
+{
+  vp::Gif gif( 4, 7, 5, 2 );
+  vp::GifImage& image = gif[1];
+
+  uint8_t Row[7] = { 1, 2, 3, 4, 5, 6, 7 };
+  image.SetRow( 3, Row );
+  CPPUNIT_ASSERT( image.GetPixel( 0, 3 ) == 1 );
+  CPPUNIT_ASSERT( image.GetPixel( 6, 3 ) == 7 );
+  CPPUNIT_ASSERT( image.GetPixel( 6, 2 ) == 0 );
+
+  uint8_t Out[7] = {};
+  image.GetRow( 3, Out );
+  CPPUNIT_ASSERT( std::equal( Out, Out + 7, Row ) );
+
+  uint8_t Rect[4] = { 15, 14, 13, 12 };
+  image.SetRect( 5, 0, 2, 2, Rect );
+  image.GetRect( 4, 1, 3, 1, Out );
+  CPPUNIT_ASSERT( Out[0] == 0 && Out[1] == 13 && Out[2] == 12 );
+
+  const uint8_t* pData = image.Data();
+  CPPUNIT_ASSERT( pData[5] == 15 );
+  CPPUNIT_ASSERT( pData[7*3 + 6] == 7 );
+  for( uint16_t y = 0; y < 5; ++y )
+    for( uint16_t x = 0; x < 7; ++x )
+      CPPUNIT_ASSERT( pData[7*y + x] == image.GetPixel( x, y ) );
+
+  // written as set
+  std::vector<uint8_t> Data;
+  gif.ExportTo( Data );
+  vp::Gif gif2;
+  gif2.Import( Data.data(), Data.size(), true );
+  CPPUNIT_ASSERT( std::equal( pData, pData + 35, gif2[1].Data() ) );
+
+  // out of range
+  Row[2] = 16;
+  CPPUNIT_ASSERT_THROW( image.SetRow( 0, Row ), vp::Exception );
+  CPPUNIT_ASSERT_THROW( image.GetRow( 5, Out ), vp::Exception );
+  CPPUNIT_ASSERT_THROW( image.SetRect( 6, 0, 2, 1, Rect ), vp::Exception );
+  CPPUNIT_ASSERT( image.GetPixel( 2, 0 ) == 0 );
+}
+
+void GifTest::testRGBA()
+{
+  vp::Gif gif( 2, 5, 4, 2, true );
+  for( uint8_t i = 0; i < 4; ++i )
+    gif.SetColorTable( i, static_cast<uint8_t>(10*i), static_cast<uint8_t>(10*i + 1),
+                       static_cast<uint8_t>(10*i + 2) );
+  for( uint16_t y = 0; y < 4; ++y )
+    for( uint16_t x = 0; x < 5; ++x )
+      gif[0].SetPixel( x, y, static_cast<uint8_t>((x + y) % 4) );
+
+  // whole image, the same as GetPixel()
+  uint8_t RGB[5*4*3];
+  gif[0].GetRGB( RGB );
+  uint8_t RGBA[5*4*4];
+  gif[0].GetRGBA( RGBA );
+  for( uint16_t y = 0; y < 4; ++y )
+  {
+    for( uint16_t x = 0; x < 5; ++x )
+    {
+      uint8_t R, G, B;
+      gif[0].GetPixel( x, y, R, G, B );
+      size_t i = static_cast<size_t>(5*y + x);
+      CPPUNIT_ASSERT( RGB[3*i] == R && RGB[3*i + 1] == G && RGB[3*i + 2] == B );
+      CPPUNIT_ASSERT( RGBA[4*i] == R && RGBA[4*i + 1] == G && RGBA[4*i + 2] == B );
+      CPPUNIT_ASSERT( RGBA[4*i + 3] == 255 );
+    }
+  }
+
+  // transparent color, in a rectangle
+  gif[0].HasTransColor( true );
+  gif[0].TransColor( 2 );
+  uint8_t Rect[2*3*4];
+  gif[0].GetRGBA( 3, 1, 2, 3, Rect );
+  for( uint16_t y = 0; y < 3; ++y )
+  {
+    for( uint16_t x = 0; x < 2; ++x )
+    {
+      const uint8_t* p = Rect + 4*(2*y + x);
+      uint8_t Index = static_cast<uint8_t>((x + 3 + y + 1) % 4);
+      CPPUNIT_ASSERT( p[0] == 10*Index && p[1] == 10*Index + 1 && p[2] == 10*Index + 2 );
+      CPPUNIT_ASSERT( p[3] == (Index == 2? 0 : 255) );
+    }
+  }
+
+  // local color table
+  gif[1].ColorTableSize( 4 );
+  gif[1].SetColorTable( 1, 7, 8, 9 );
+  gif[1].SetPixel( 4, 3, 1 );
+  uint8_t Pixel[3];
+  gif[1].GetRGB( 4, 3, 1, 1, Pixel );
+  CPPUNIT_ASSERT( Pixel[0] == 7 && Pixel[1] == 8 && Pixel[2] == 9 );
+
+  // out of range
+  CPPUNIT_ASSERT_THROW( gif[0].GetRGB( 4, 0, 2, 1, RGB ), vp::Exception );
+  CPPUNIT_ASSERT_THROW( gif[0].GetRGBA( 0, 2, 1, 3, RGBA ), vp::Exception );
+}
+
+void GifTest::testCropAll()
+{
+  // 20 x 10 screen, image 1 at (12, 2) of 6 x 5, image 2 at (0, 0) of 3 x 3
+  vp::Gif gif( 4, 20, 10, 3 );
+  for( uint16_t y = 0; y < 10; ++y )
+    for( uint16_t x = 0; x < 20; ++x )
+      gif[0].SetPixel( x, y, static_cast<uint8_t>((x + y) % 16) );
+  gif[1].Crop( 12, 2, 6, 5 );
+  gif[1].SetAllPixels( 7 );
+  gif[1].SetPixel( 0, 0, 5 );
+  gif[2].Crop( 0, 0, 3, 3 );
+  gif[2].SetAllPixels( 9 );
+
+  gif.CropAll( 10, 3, 8, 6 );
+  CPPUNIT_ASSERT( gif.Width() == 8 );
+  CPPUNIT_ASSERT( gif.Height() == 6 );
+
+  // full screen image
+  CPPUNIT_ASSERT( gif[0].Left() == 0 && gif[0].Top() == 0 );
+  CPPUNIT_ASSERT( gif[0].Width() == 8 && gif[0].Height() == 6 );
+  for( uint16_t y = 0; y < 6; ++y )
+    for( uint16_t x = 0; x < 8; ++x )
+      CPPUNIT_ASSERT( gif[0].GetPixel( x, y ) == (x + 10 + y + 3) % 16 );
+
+  // partly within, row 2 and below of the image
+  CPPUNIT_ASSERT( gif[1].Left() == 2 && gif[1].Top() == 0 );
+  CPPUNIT_ASSERT( gif[1].Width() == 6 && gif[1].Height() == 4 );
+  CPPUNIT_ASSERT( gif[1].GetPixel( 0, 0 ) == 7 );
+
+  // entirely outside
+  CPPUNIT_ASSERT( gif[2].Left() == 0 && gif[2].Top() == 0 );
+  CPPUNIT_ASSERT( gif[2].Width() == 1 && gif[2].Height() == 1 );
+  CPPUNIT_ASSERT( gif[2].HasTransColor() );
+  CPPUNIT_ASSERT( gif[2].Transparent( 0, 0 ) );
+
+  // written and read back
+  std::vector<uint8_t> Data;
+  gif.ExportTo( Data );
+  vp::Gif gif2;
+  gif2.Import( Data.data(), Data.size() );
+  CPPUNIT_ASSERT( gif2.Width() == 8 && gif2.Height() == 6 );
+  CPPUNIT_ASSERT( gif2[1].Left() == 2 && gif2[1].Height() == 4 );
+  CPPUNIT_ASSERT( gif2[0].GetPixel( 7, 5 ) == (7 + 10 + 5 + 3) % 16 );
+
+  // out of range
+  CPPUNIT_ASSERT_THROW( gif.CropAll( 1, 0, 8, 1 ), vp::Exception );
+  CPPUNIT_ASSERT_THROW( gif.CropAll( 0, 0, 0, 1 ), vp::Exception );
+  CPPUNIT_ASSERT_THROW( gif.CropAll( 0, 5, 1, 2 ), vp::Exception );
+}
+
+namespace
+{
+  // all frames of an animation, rendered
+  std::vector<std::vector<uint8_t>> RenderAll( const vp::Gif& gif )
+  {
+    std::vector<std::vector<uint8_t>> Frames;
+    vp::GifRenderer renderer( gif );
+    size_t Size = 4*static_cast<size_t>(gif.Width())*gif.Height();
+    for( size_t i = 0; i < gif.Images(); ++i )
+    {
+      const uint8_t* p = renderer.Render( i );
+      Frames.emplace_back( p, p + Size );
+    }
+
+    return Frames;
+  }
+}
+
+void GifTest::testOptimizeFrames()
+{
+  // 24 x 16 screen
+  vp::Gif gif( 4, 24, 16, 8 );
+  for( uint16_t i = 0; i < 16; ++i )
+    gif.SetColorTable( static_cast<uint8_t>(i), static_cast<uint8_t>(i*16), 0, 0 );
+
+  // 0, 1, 2, 4: full screen, 1 with a 3 x 3 square changed, 2 the same as 1
+  for( size_t i : { 0, 1, 2, 4 } )
+    for( uint16_t y = 0; y < 16; ++y )
+      for( uint16_t x = 0; x < 24; ++x )
+        gif[i].SetPixel( x, y, static_cast<uint8_t>((x + 3*y) % 12 + 1) );
+  for( size_t i : { 1, 2 } )
+    for( uint16_t y = 4; y < 7; ++y )
+      for( uint16_t x = 5; x < 8; ++x )
+        gif[i].SetPixel( x, y, 13 );
+
+  // 3: 6 x 6 at (10, 2), partly transparent, restored to background
+  gif[3].Crop( 10, 2, 6, 6 );
+  for( uint16_t y = 0; y < 6; ++y )
+    for( uint16_t x = 0; x < 6; ++x )
+      gif[3].SetPixel( x, y, ((x + y) % 3 == 0)? 15 : 14 );
+  gif[3].TransColor( 15 );
+  gif[3].DisposalMethod( 2 );
+
+  // 5: restored to previous, 6: restored to background, 7: mostly
+  // transparent, can not clear the area of 6
+  gif[5].Crop( 0, 0, 4, 4 );
+  gif[5].SetAllPixels( 14 );
+  gif[5].DisposalMethod( 3 );
+  gif[6].Crop( 20, 12, 4, 4 );
+  gif[6].SetAllPixels( 13 );
+  gif[6].DisposalMethod( 2 );
+  gif[7].Crop( 2, 2, 3, 3 );
+  gif[7].SetAllPixels( 15 );
+  gif[7].SetPixel( 1, 1, 14 );
+  gif[7].TransColor( 15 );
+
+  auto Frames = RenderAll( gif );
+  std::vector<uint8_t> Before;
+  gif.ExportTo( Before );
+  CPPUNIT_ASSERT( gif.OptimizeFrames() );
+  CPPUNIT_ASSERT( RenderAll( gif ) == Frames );
+
+  // reduced to the change
+  CPPUNIT_ASSERT( gif[1].Left() == 5 && gif[1].Top() == 4 );
+  CPPUNIT_ASSERT( gif[1].Width() == 3 && gif[1].Height() == 3 );
+  CPPUNIT_ASSERT( gif[2].Width() == 1 && gif[2].Height() == 1 );
+  CPPUNIT_ASSERT( gif[4].Width() < 24 && gif[4].Height() < 16 );
+  CPPUNIT_ASSERT( gif[4].HasTransColor() );
+  CPPUNIT_ASSERT( gif[3].DisposalMethod() == 1 );
+
+  // left as they are
+  CPPUNIT_ASSERT( gif[5].Width() == 4 && gif[5].DisposalMethod() == 3 );
+  CPPUNIT_ASSERT( gif[6].Width() == 4 && gif[6].DisposalMethod() == 2 );
+  CPPUNIT_ASSERT( gif[7].Width() == 3 && gif[7].Left() == 2 );
+
+  // smaller, and the same once written and read back
+  std::vector<uint8_t> Data;
+  gif.ExportTo( Data );
+  CPPUNIT_ASSERT( Data.size() < Before.size() );
+  vp::Gif gif2;
+  gif2.Import( Data.data(), Data.size() );
+  CPPUNIT_ASSERT( RenderAll( gif2 ) == Frames );
+
+  // nothing more to do
+  CPPUNIT_ASSERT( !gif2.OptimizeFrames() );
+  CPPUNIT_ASSERT( RenderAll( gif2 ) == Frames );
+
+  // single image
+  vp::Gif gif3( 4, 8, 8 );
+  CPPUNIT_ASSERT( !gif3.OptimizeFrames() );
+}
+
 void GifTest::testColorTableSize()
 {
   vp::Gif gif( 3, 10, 10, 3, true );
@@ -34,6 +34,16 @@ class GifTest : public CPPUNIT_NS::TestCase
 
   CPPUNIT_TEST( testImport );
   CPPUNIT_TEST( testExport );
+  CPPUNIT_TEST( testMemoryIO );
+  CPPUNIT_TEST( testLazyImport );
+  CPPUNIT_TEST( testLazyThreads );
+  CPPUNIT_TEST( testThreads );
+  CPPUNIT_TEST( testImageThreads );
+  CPPUNIT_TEST( testInterlaced );
+  CPPUNIT_TEST( testBulkPixels );
+  CPPUNIT_TEST( testRGBA );
+  CPPUNIT_TEST( testCropAll );
+  CPPUNIT_TEST( testOptimizeFrames );
 
   CPPUNIT_TEST( testColorTableSize );
   CPPUNIT_TEST( testBitsPerPixel );
@@ -48,6 +58,16 @@ protected:
   void testTwoImages();
   void testImport();
   void testExport();
+  void testMemoryIO();
+  void testLazyImport();
+  void testLazyThreads();
+  void testThreads();
+  void testImageThreads();
+  void testInterlaced();
+  void testBulkPixels();
+  void testRGBA();
+  void testCropAll();
+  void testOptimizeFrames();
   void testColorTableSize();
   void testBitsPerPixel();
   void testRemove();
@@ -335,6 +335,27 @@ function TestBmp:testExport()
   lu.assertError( bmp.export, bmp, 'temp.bmp', false )
 end
 
+function TestBmp:testString()
+  local bmp = vpixels.bmp( 4, 5, 6 )
+  bmp:setpixel( 2, 3, 9 )
+  local data = bmp:exportstring()
+  lu.assertEquals( data:sub( 1, 2 ), 'BM' )
+
+  local bmp2 = vpixels.bmp()
+  bmp2:importstring( data )
+  lu.assertEquals( 4, bmp2:bpp() )
+  lu.assertEquals( 5, bmp2:width() )
+  lu.assertEquals( 6, bmp2:height() )
+  lu.assertEquals( 9, bmp2:getpixel( 2, 3 ) )
+  lu.assertEquals( bmp2:exportstring(), data )
+
+  -- importstring() expects a string argument
+  lu.assertError( bmp2.importstring, bmp2, {} )
+
+  -- truncated bmp data
+  lu.assertError( bmp2.importstring, bmp2, data:sub( 1, -11 ) )
+end
+
 -- test LuaUtil::NewIndex()
 -- b/c __newindex of LuaBmp delegates to LuaUtil::NewIndex()
 function TestBmp:testNewIndex()
@@ -233,6 +233,32 @@ function TestGif:testExport()
   lu.assertError( gif.export, gif, "temp.gif", false )
 end
 
+function TestGif:testString()
+  local gif = vpixels.gif( 3, 4, 5, 2 )
+  gif[1]:setpixel( 2, 3, 6 )
+  local data = gif:exportstring()
+  lu.assertEquals( data:sub( 1, 6 ), "GIF89a" )
+
+  local gif2 = vpixels.gif()
+  local img0 = gif2[0]
+  gif2:importstring( data )
+  lu.assertEquals( gif2:bpp(), 3 )
+  lu.assertEquals( gif2:width(), 4 )
+  lu.assertEquals( gif2:height(), 5 )
+  lu.assertEquals( #gif2, 2 )
+  lu.assertEquals( gif2[1]:getpixel( 2, 3 ), 6 )
+  lu.assertEquals( gif2:exportstring(), data )
+  -- previously returned images are invalidated
+  lu.assertError( img0.bpp, img0 )
+
+  -- importstring() expects a string argument
+  lu.assertError( gif2.importstring, gif2, {} )
+  lu.assertEquals( #gif2, 2 )
+
+  -- truncated gif data
+  lu.assertError( gif2.importstring, gif2, data:sub( 1, -2 ) )
+end
+
 function TestGif:testColorTableSize()
   local gif = vpixels.gif( 3, 3, 4, 3 )
   lu.assertTrue( gif:colortable() )
@@ -839,6 +865,26 @@ function TestGifImage:testMethodsNoArg()
   lu.assertFalse( img:colortablesorted() )
 end
 
+function TestGifImage:testInterlaced()
+  local gif = vpixels.gif( 3, 4, 9, 2 )
+  local img = gif[1]
+  img:setpixel( 2, 3, 6 )
+  img:interlaced( true )
+  lu.assertTrue( img:interlaced() )
+  lu.assertFalse( gif[0]:interlaced() )
+
+  local gif2 = vpixels.gif()
+  gif2:importstring( gif:exportstring() )
+  lu.assertTrue( gif2[1]:interlaced() )
+  lu.assertEquals( gif2[1]:getpixel( 2, 3 ), 6 )
+
+  gif2[1]:interlaced( false )
+  lu.assertFalse( gif2[1]:interlaced() )
+
+  -- wrong args
+  lu.assertError( img.interlaced, img, 1 )
+end
+
 function TestGifImage:testClone()
   local gif = vpixels.gif( 2, 3, 4, 5 )
   local img0 = gif[0]
@@ -268,6 +268,26 @@ class TestBmp( unittest.TestCase ):
     self.assertRaises( IOError, bmp.export, 'temp.bmp', False ) # overwrite = False
 
 
+  def testBytes( self ):
+    bmp = vpixels.bmp( 4, 5, 6 )
+    bmp.setpixel( 2, 3, 9 )
+    data = bmp.exportbytes()
+    self.assertEqual( 'BM', data[:2] )
+
+    bmp2 = vpixels.bmp()
+    bmp2.importbytes( data )
+    self.assertEqual( 4, bmp2.bpp() )
+    self.assertEqual( (5, 6), bmp2.dimension() )
+    self.assertEqual( 9, bmp2.getpixel( 2, 3 ) )
+    self.assertEqual( data, bmp2.exportbytes() )
+
+    # importbytes() expects a string argument
+    self.assertRaises( TypeError, bmp2.importbytes, 2 )
+
+    # truncated bmp data
+    self.assertRaises( Exception, bmp2.importbytes, data[:-10] )
+
+
   def testInheritance( self ):
     class subbmp( vpixels.bmp ):
       def __init__( self ):
@@ -623,6 +623,31 @@ class TestGif( unittest.TestCase ):
     self.assertRaises( IOError, gif.export, 'temp.gif', False ) # overwrite = False
 
 
+  def testBytes( self ):
+    gif = vpixels.gif( 3, 4, 5, 2 )
+    gif[1].setpixel( 2, 3, 6 )
+    data = gif.exportbytes()
+    self.assertEqual( 'GIF89a', data[:6] )
+
+    gif2 = vpixels.gif()
+    img0 = gif2[0]
+    gif2.importbytes( data )
+    self.assertEqual( 3, gif2.bpp() )
+    self.assertEqual( (4, 5), gif2.dimension() )
+    self.assertEqual( 2, len(gif2) )
+    self.assertEqual( 6, gif2[1].getpixel( 2, 3 ) )
+    self.assertEqual( data, gif2.exportbytes() )
+    # previously returned images are invalidated
+    self.assertRaises( Exception, img0.bpp )
+
+    # importbytes() expects a string argument
+    self.assertRaises( TypeError, gif2.importbytes, 2 )
+    self.assertEqual( 2, len(gif2) )
+
+    # truncated gif data
+    self.assertRaises( Exception, gif2.importbytes, data[:-1] )
+
+
   def testInheritance( self ):
     class subgif( vpixels.gif ):
       def __init__( self ):
@@ -760,6 +785,26 @@ class TestGifImage( unittest.TestCase ):
     self.assertEqual( False, img.interlaced() )
 
 
+  def testInterlaced(self):
+    gif = vpixels.gif( 3, 4, 9, 2 )
+    img = gif[1]
+    img.setpixel( 2, 3, 6 )
+    img.interlaced( True )
+    self.assertEqual( True, img.interlaced() )
+    self.assertEqual( False, gif[0].interlaced() )
+
+    gif2 = vpixels.gif()
+    gif2.importbytes( gif.exportbytes() )
+    self.assertEqual( True, gif2[1].interlaced() )
+    self.assertEqual( 6, gif2[1].getpixel( 2, 3 ) )
+
+    gif2[1].interlaced( False )
+    self.assertEqual( False, gif2[1].interlaced() )
+
+    # wrong args
+    self.assertRaises( TypeError, img.interlaced, 1 )
+
+
   def testClone(self):
     gif = vpixels.gif( 2, 3, 4, 5 )
     img0 = gif[0]
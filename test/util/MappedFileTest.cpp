@@ -0,0 +1,130 @@
+////////////////////////////////////////////////////////////////////////
+// Copyright (C) 2019 Xueyi Yao
+//
+// This file is part of VPixels.
+//
+// VPixels is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+// 
+// VPixels is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+// 
+// You should have received a copy of the GNU General Public License
+// along with VPixels.  If not, see <https://www.gnu.org/licenses/>.
+////////////////////////////////////////////////////////////////////////
+
+#include <cstdio>
+#include <fstream>
+#include <istream>
+#include "MappedFileTest.h"
+#include "MappedFile.h"
+#include "MemoryBuf.h"
+
+CPPUNIT_TEST_SUITE_REGISTRATION( MappedFileTest );
+
+namespace
+{
+  // write Size bytes of 0, 1, 2, ... into file
+  void WriteFile( const char* FileName, const size_t Size )
+  {
+    std::ofstream File( FileName, std::ios::binary );
+    for( size_t i = 0; i < Size; ++i )
+      File.put( static_cast<char>(i & 0xFF) );
+  }
+}
+
+void MappedFileTest::testNotExist()
+{
+  MappedFile File( "not_exist.bin" );
+  CPPUNIT_ASSERT( !File );
+  CPPUNIT_ASSERT( File.Data() == nullptr );
+  CPPUNIT_ASSERT( File.Size() == 0 );
+}
+
+void MappedFileTest::testEmpty()
+{
+  WriteFile( "mapped_empty.bin", 0 );
+  {
+    MappedFile File( "mapped_empty.bin" );
+    CPPUNIT_ASSERT( static_cast<bool>(File) );
+    CPPUNIT_ASSERT( File.Size() == 0 );
+  }
+  std::remove( "mapped_empty.bin" );
+}
+
+void MappedFileTest::testContent()
+{
+  WriteFile( "mapped_file.bin", 10000 );
+  {
+    MappedFile File( "mapped_file.bin" );
+    CPPUNIT_ASSERT( static_cast<bool>(File) );
+    CPPUNIT_ASSERT( File.Size() == 10000 );
+    for( size_t i = 0; i < File.Size(); ++i )
+      CPPUNIT_ASSERT( File.Data()[i] == (i & 0xFF) );
+  }
+  std::remove( "mapped_file.bin" );
+}
+
+// read through std::istream
+void MappedFileTest::testMemoryBuf()
+{
+  const uint8_t Data[] = { 0x47, 0x49, 0x46, 0x38, 0x39, 0x61 };
+  MemoryBuf Buffer( Data, sizeof(Data) );
+  std::istream is( &Buffer );
+
+  CPPUNIT_ASSERT( is.get() == 0x47 );
+  char Bytes[4] = {};
+  is.read( Bytes, 4 );
+  CPPUNIT_ASSERT( is.good() );
+  CPPUNIT_ASSERT( std::string( Bytes, 4 ) == "IF89" );
+  CPPUNIT_ASSERT( Buffer.Remaining() == 1 );
+  CPPUNIT_ASSERT( *Buffer.Current() == 0x61 );
+
+  is.get();
+  CPPUNIT_ASSERT( is.good() );
+  is.get();
+  CPPUNIT_ASSERT( is.eof() );
+}
+
+// skip bytes without the stream
+void MappedFileTest::testAdvance()
+{
+  const uint8_t Data[] = { 1, 2, 3, 4, 5 };
+  MemoryBuf Buffer( Data, sizeof(Data) );
+  std::istream is( &Buffer );
+
+  CPPUNIT_ASSERT( is.get() == 1 );
+  Buffer.Advance( 2 );
+  CPPUNIT_ASSERT( is.get() == 4 );
+  Buffer.Advance( 10 );
+  CPPUNIT_ASSERT( Buffer.Remaining() == 0 );
+  is.get();
+  CPPUNIT_ASSERT( is.eof() );
+}
+
+void MappedFileTest::testSeek()
+{
+  const uint8_t Data[] = { 1, 2, 3, 4, 5 };
+  MemoryBuf Buffer( Data, sizeof(Data) );
+  std::istream is( &Buffer );
+
+  CPPUNIT_ASSERT( is.tellg() == 0 );
+  is.get();
+  is.get();
+  CPPUNIT_ASSERT( is.tellg() == 2 );
+
+  is.seekg( 4 );
+  CPPUNIT_ASSERT( is.get() == 5 );
+  is.seekg( -2, std::ios_base::end );
+  CPPUNIT_ASSERT( is.get() == 4 );
+  is.seekg( -2, std::ios_base::cur );
+  CPPUNIT_ASSERT( is.get() == 3 );
+
+  // out of range
+  is.seekg( 6 );
+  CPPUNIT_ASSERT( is.fail() );
+}
@@ -0,0 +1,86 @@
+////////////////////////////////////////////////////////////////////////
+// Copyright (C) 2019 Xueyi Yao
+//
+// This file is part of VPixels.
+//
+// VPixels is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+// 
+// VPixels is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+// 
+// You should have received a copy of the GNU General Public License
+// along with VPixels.  If not, see <https://www.gnu.org/licenses/>.
+////////////////////////////////////////////////////////////////////////
+
+#include <atomic>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+#include "ParallelForTest.h"
+#include "ParallelFor.h"
+
+CPPUNIT_TEST_SUITE_REGISTRATION( ParallelForTest );
+
+void ParallelForTest::testThreads()
+{
+  CPPUNIT_ASSERT( Parallel::Threads( 1 ) == 1 );
+  CPPUNIT_ASSERT( Parallel::Threads( 7 ) == 7 );
+
+  unsigned Hardware = std::thread::hardware_concurrency();
+  CPPUNIT_ASSERT( Parallel::Threads( 0 ) == (Hardware == 0 ? 1 : Hardware) );
+}
+
+void ParallelForTest::testFor()
+{
+  // each index is visited exactly once
+  for( unsigned Threads : { 0u, 1u, 2u, 4u, 64u } )
+  {
+    for( size_t Count : { 0u, 1u, 3u, 1000u } )
+    {
+      std::vector<std::atomic<int>> Visits( Count );
+      for( auto& Visit : Visits )
+        Visit = 0;
+
+      Parallel::For( Count, Threads, [&]( const size_t i ) { ++Visits[i]; } );
+
+      for( auto& Visit : Visits )
+        CPPUNIT_ASSERT( Visit == 1 );
+    }
+  }
+
+  // serial, in order, on the calling thread
+  std::vector<size_t> Order;
+  std::thread::id Caller = std::this_thread::get_id();
+  bool SameThread = true;
+  Parallel::For( 10, 1, [&]( const size_t i ) {
+    Order.push_back( i );
+    SameThread = SameThread && (std::this_thread::get_id() == Caller);
+  } );
+  CPPUNIT_ASSERT( Order.size() == 10 );
+  for( size_t i = 0; i < Order.size(); ++i )
+    CPPUNIT_ASSERT( Order[i] == i );
+  CPPUNIT_ASSERT( SameThread );
+}
+
+void ParallelForTest::testException()
+{
+  // exception is passed on to the caller, for any number of threads
+  for( unsigned Threads : { 1u, 4u } )
+  {
+    std::atomic<size_t> Done( 0 );
+    CPPUNIT_ASSERT_THROW(
+      Parallel::For( 100, Threads, [&]( const size_t i ) {
+        if( i == 10 )
+          throw std::runtime_error( "job failed" );
+        ++Done;
+      } ),
+      std::runtime_error );
+
+    CPPUNIT_ASSERT( Done < 100 );
+  }
+}